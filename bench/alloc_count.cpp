@@ -0,0 +1,60 @@
+#include "alloc_count.h"
+
+#if !defined(ARDUINO) && defined(__GLIBC__)
+#include <stddef.h>
+#include <atomic>
+
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void* __libc_memalign(size_t align, size_t size);
+void  __libc_free(void* p);
+}
+
+static std::atomic<bool>     counting(false);
+static std::atomic<uint64_t> allocs(0);
+
+static void count() {
+  if (counting.load(std::memory_order_relaxed)) {
+    allocs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+extern "C" {
+void* malloc(size_t size) { count(); return __libc_malloc(size); }
+void* calloc(size_t n, size_t size) { count(); return __libc_calloc(n, size); }
+void* realloc(void* p, size_t size) { count(); return __libc_realloc(p, size); }
+void  free(void* p) { __libc_free(p); }
+
+void* aligned_alloc(size_t align, size_t size) {
+  count();
+  return __libc_memalign(align, size);
+}
+
+int posix_memalign(void** out, size_t align, size_t size) {
+  count();
+  *out = __libc_memalign(align, size);
+  return *out ? 0 : 12;   // ENOMEM
+}
+}
+
+bool allocCountAvailable() { return true; }
+
+void allocCountStart() {
+  allocs = 0;
+  counting = true;
+}
+
+uint64_t allocCountStop() {
+  counting = false;
+  return allocs;
+}
+
+#else
+
+bool allocCountAvailable() { return false; }
+void allocCountStart() {}
+uint64_t allocCountStop() { return 0; }
+
+#endif
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stdint.h>
+
+// ---------------------------
+// COUNTING ALLOCATOR (native only)
+// ---------------------------
+// Interposes malloc/calloc/realloc/free (and therefore operator new) on
+// glibc and counts calls made between allocCountStart() and
+// allocCountStop(). allocCountAvailable() is false where interposition
+// is not supported, in which case counts are always 0.
+
+bool     allocCountAvailable();
+void     allocCountStart();
+uint64_t allocCountStop();   // allocations since start
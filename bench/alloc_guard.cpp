@@ -0,0 +1,119 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "alloc_count.h"
+#include "alloc_guard.h"
+#include "commands.h"
+#include "hit_packet.h"
+#include "hit_pipeline.h"
+#include "match_auth.h"
+#include "pools.h"
+
+// ---------------------------
+// ALLOCATION GUARD: camera -> broadcast
+// ---------------------------
+// Builds the pipeline the way setup() does (allocations allowed), then
+// replays a long camera stream through it with the counting allocator
+// armed. A match key is set up first, and the sink does what
+// broadcastHit() does per hit: signs the WS frame into a pooled payload,
+// encodes the UDP HitPacket like udpHitsSend() and tags it.
+// MATCH_START / MATCH_END commands are interleaved so the match gate
+// flips. Packets and commands go through the fixed pools the way the
+// firmware uses them. Any allocation after "setup" fails the run.
+
+static MatchAuth guardAuth;
+static uint8_t   packetOut[HIT_PACKET_SIZE];
+static uint32_t  packetsEncoded = 0;
+static uint32_t  hitsSigned = 0;
+
+static void guardSink(const HitEvent& hit) {
+  WsPayload* w = wsPayloadPool.acquire();
+  if (w) {
+    w->len = (uint16_t)guardAuth.signHit(hit.seq, hit.timeMs, w->data, sizeof(w->data));
+    if (w->len > 0) hitsSigned++;
+    wsPayloadPool.release(w);
+  }
+
+  RadioPacket* p = radioPacketPool.acquire();
+  if (!p) return;
+  p->pkt = { HIT_PACKET_HIT, 1, 1, hit.seq, hit.timeMs, 0, 3 };
+  encodeHitPacket(p->pkt, packetOut);
+  p->tagged = guardAuth.tagPacket(packetOut, p->tag);
+  radioPacketPool.release(p);
+  packetsEncoded++;
+}
+
+// A signed MATCH_START as the phone sends it, so signHit / tagPacket
+// have a match key.
+static bool guardMatchKey() {
+  HmacSha256 planeKey;
+  guardAuth.begin("guard secret", 1, 1);
+  authPlaneKey(planeKey, "guard secret", 1);
+
+  char line[AUTH_LINE_MAX];
+  size_t n = authSignMatchStart(planeKey, 2, guardAuth.challenge(), line, sizeof(line));
+  PhoneCommand cmd;
+  return guardAuth.verifyCommand(line, n, cmd, 3) == AUTH_OK;
+}
+
+static PhoneCommand guardCommand(const char* text, size_t len) {
+  CommandBuffer* c = poolCommand(text, len);
+  if (!c) return CMD_UNKNOWN;
+  PhoneCommand cmd = parseCommand(c->data, c->len);
+  commandPool.release(c);
+  return cmd;
+}
+
+static const char guardStream[] =
+    "HIT\n"
+    "  HIT \r\n"
+    "BLOB 120 88 14\n"
+    "\n"
+    "HIT\n"
+    "THIS LINE IS MUCH LONGER THAN THE CAMERA LINE BUFFER AND MUST BE DROPPED "
+    "WITHOUT GROWING ANYTHING\n";
+
+int runAllocGuard(int rounds) {
+  // --- "setup()" ---
+  static HitPipeline pipeline;
+  pipeline.setSink(guardSink);
+  bool keyed = guardMatchKey();
+
+  if (!allocCountAvailable()) {
+    puts("{\"alloc_guard\":\"hit_pipeline\",\"result\":\"unsupported\"}");
+    return 0;
+  }
+
+  allocCountStart();
+
+  // Feed in uneven chunks so lines straddle reads like a real UART.
+  const uint8_t* bytes = (const uint8_t*)guardStream;
+  size_t total = sizeof(guardStream) - 1;
+  uint32_t now = 0;
+
+  for (int r = 0; r < rounds; r++) {
+    size_t pos = 0, chunk = 1 + (size_t)(r % 17);
+    while (pos < total) {
+      size_t n = (total - pos < chunk) ? total - pos : chunk;
+      pipeline.feedCamera(bytes + pos, n, now);
+      pos += n;
+    }
+    now += 20;
+
+    if (r % 100 == 50) {
+      pipeline.setMatchActive(guardCommand("MATCH_END", 9) != CMD_MATCH_END);
+    } else if (r % 100 == 99) {
+      pipeline.setMatchActive(guardCommand(" MATCH_START\n", 13) == CMD_MATCH_START);
+    }
+  }
+
+  uint64_t allocs = allocCountStop();
+  bool pass = (allocs == 0) && packetsEncoded > 0 && keyed && hitsSigned == packetsEncoded;
+
+  printf("{\"alloc_guard\":\"hit_pipeline\",\"rounds\":%d,\"hits\":%u,\"signed\":%u,"
+         "\"ignored\":%u,\"overflows\":%u,\"allocs\":%llu,\"result\":\"%s\"}\n",
+         rounds, (unsigned)packetsEncoded, (unsigned)hitsSigned, (unsigned)pipeline.hitsIgnored,
+         (unsigned)pipeline.reader().overflows, (unsigned long long)allocs,
+         pass ? "pass" : "fail");
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Returns 0 if the camera -> broadcast path made no allocations.
+int runAllocGuard(int rounds);
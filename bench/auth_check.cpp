@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "auth_check.h"
+#include "match_auth.h"
+
+// ---------------------------
+// AUTH CHECK: command verification
+// ---------------------------
+// Feeds MatchAuth::verifyCommand the lines a phone sends and the ones an
+// attacker would: padded or oversized command words, a replayed start,
+// a replayed MATCH_END. Every case has the AuthResult it must get; any
+// other result fails the run.
+
+#define CHECK_SECRET "check secret"
+#define CHECK_PLANE  1
+
+static int failures = 0;
+
+static void expect(MatchAuth& auth, const char* name, const char* line, size_t len,
+                   AuthResult want, uint64_t nextChallenge) {
+  PhoneCommand cmd;
+  AuthResult got = auth.verifyCommand(line, len, cmd, nextChallenge);
+  if (got != want) {
+    printf("{\"auth_check\":\"%s\",\"want\":%d,\"got\":%d}\n", name, (int)want, (int)got);
+    failures++;
+  }
+}
+
+// Prefix (or suffix of the command word) + a signed start for challenge.
+static size_t paddedStart(const HmacSha256& planeKey, uint64_t challenge, const char* prefix,
+                          size_t wordPad, char* out, size_t cap) {
+  char start[AUTH_LINE_MAX];
+  size_t n = authSignMatchStart(planeKey, 2, challenge, start, sizeof(start));
+  size_t p = strlen(prefix);
+  if (p + n + wordPad > cap) return 0;
+
+  memcpy(out, prefix, p);
+  memcpy(out + p, start, 11);                      // "MATCH_START"
+  memset(out + p + 11, '\t', wordPad);
+  memcpy(out + p + 11 + wordPad, start + 11, n - 11);
+  return p + n + wordPad;
+}
+
+int runAuthCheck() {
+  static MatchAuth auth;
+  HmacSha256 planeKey;
+  authPlaneKey(planeKey, CHECK_SECRET, CHECK_PLANE);
+  auth.begin(CHECK_SECRET, CHECK_PLANE, 1);
+
+  char line[160];
+  char tabs[31];
+  memset(tabs, '\t', 30);
+  tabs[30] = '\0';
+  size_t n;
+
+  // Padded and oversized command words never reach the start check.
+  n = paddedStart(planeKey, 1, tabs, 0, line, sizeof(line));
+  expect(auth, "leading_tabs", line, n, AUTH_BAD_FORMAT, 9);
+  n = paddedStart(planeKey, 1, "", 2, line, sizeof(line));
+  expect(auth, "padded_word", line, n, AUTH_BAD_FORMAT, 9);
+  n = paddedStart(planeKey, 1, "", 60, line, sizeof(line));
+  expect(auth, "oversized_word", line, n, AUTH_BAD_FORMAT, 9);
+  memset(line, '\t', 95);
+  memcpy(line + 84, "MATCH_START", 11);
+  expect(auth, "tabs_only", line, 95, AUTH_UNSIGNED, 9);
+
+  // Unsigned, then the real start; the challenge moves on to 3.
+  expect(auth, "unsigned_start", "MATCH_START", 11, AUTH_UNSIGNED, 9);
+  n = authSignMatchStart(planeKey, 2, 1, line, sizeof(line));
+  expect(auth, "start", line, n, AUTH_OK, 3);
+  expect(auth, "start_replayed", line, n, AUTH_BAD_TAG, 4);
+  line[n - 1] ^= 1;
+  expect(auth, "start_bad_tag", line, n, AUTH_BAD_TAG, 4);
+
+  // MATCH_END under the key of that match, once.
+  HmacSha256 matchKey;
+  authMatchKey(matchKey, planeKey, 2, 1);
+  n = authSignLine(matchKey, "MATCH_END 1", 11, line, sizeof(line));
+  expect(auth, "end", line, n, AUTH_OK, 5);
+  expect(auth, "end_replayed", line, n, AUTH_REPLAY, 5);
+
+  bool pass = failures == 0;
+  printf("{\"auth_check\":\"match_auth\",\"failures\":%d,\"result\":\"%s\"}\n",
+         failures, pass ? "pass" : "fail");
+  return pass ? 0 : 1;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Returns 0 if MatchAuth accepted and rejected every case as expected.
+int runAuthCheck();
@@ -0,0 +1,120 @@
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "alloc_count.h"
+#include "bench.h"
+#include "version.h"
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+static uint32_t ticksNow() { return ESP.getCycleCount(); }
+static uint32_t ticksSince(uint32_t start) { return ticksNow() - start; }
+typedef uint32_t Ticks;
+#else
+#include <time.h>
+
+static uint64_t ticksNow() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+static uint64_t ticksSince(uint64_t start) { return ticksNow() - start; }
+typedef uint64_t Ticks;
+#endif
+
+#define BENCH_MAX_SAMPLES 101
+
+struct Stats {
+  double min, max, median, mean, stddev, mad, ciLo, ciHi;
+};
+
+static Ticks timeBatch(const BenchKernel& k, uint32_t iters) {
+  Ticks start = ticksNow();
+  k.run(iters);
+  return ticksSince(start);
+}
+
+// Doubles the batch until one batch takes at least BENCH_SAMPLE_TICKS.
+static uint32_t calibrate(const BenchKernel& k) {
+  uint32_t iters = 1;
+  while (iters < (1u << 24)) {
+    if (timeBatch(k, iters) >= (Ticks)BENCH_SAMPLE_TICKS) break;
+    iters *= 2;
+  }
+  return iters;
+}
+
+static double medianOf(double* sorted, int n) {
+  return (n & 1) ? sorted[n / 2] : 0.5 * (sorted[n / 2 - 1] + sorted[n / 2]);
+}
+
+static Stats summarize(double* s, int n) {
+  Stats st;
+  std::sort(s, s + n);
+
+  st.min = s[0];
+  st.max = s[n - 1];
+  st.median = medianOf(s, n);
+
+  double sum = 0;
+  for (int i = 0; i < n; i++) sum += s[i];
+  st.mean = sum / n;
+
+  double var = 0;
+  for (int i = 0; i < n; i++) var += (s[i] - st.mean) * (s[i] - st.mean);
+  st.stddev = n > 1 ? sqrt(var / (n - 1)) : 0;
+
+  double dev[BENCH_MAX_SAMPLES];
+  for (int i = 0; i < n; i++) dev[i] = fabs(s[i] - st.median);
+  std::sort(dev, dev + n);
+  st.mad = medianOf(dev, n);
+
+  // Distribution-free CI of the median: order statistics at
+  // n/2 -+ 1.96*sqrt(n)/2 (normal approximation to the binomial).
+  double half = 0.98 * sqrt((double)n);
+  int lo = (int)floor(n / 2.0 - half);
+  int hi = (int)ceil(n / 2.0 + half);
+  st.ciLo = s[std::max(lo, 0)];
+  st.ciHi = s[std::min(hi, n - 1)];
+  return st;
+}
+
+int benchRunAll(const BenchOptions& opt, BenchEmit emit) {
+  int samples = std::min(std::max(opt.samples, 5), BENCH_MAX_SAMPLES);
+  int ran = 0;
+
+  for (size_t i = 0; i < benchKernelCount; i++) {
+    const BenchKernel& k = benchKernels[i];
+    if (opt.filter && !strstr(k.name, opt.filter)) continue;
+
+    uint32_t iters = calibrate(k);
+    for (int w = 0; w < BENCH_WARMUP; w++) timeBatch(k, iters);
+
+    double perOp[BENCH_MAX_SAMPLES];
+    for (int s = 0; s < samples; s++) {
+      perOp[s] = (double)timeBatch(k, iters) / iters;
+    }
+    Stats st = summarize(perOp, samples);
+
+    allocCountStart();
+    k.run(iters);
+    double allocsPerOp = (double)allocCountStop() / iters;
+
+    char line[BENCH_LINE_MAX];
+    snprintf(line, sizeof(line),
+             "{\"bench\":\"aeroduel\",\"fw\":\"%s\",\"target\":\"%s\","
+             "\"kernel\":\"%s\",\"unit\":\"%s\",\"batch\":%u,\"samples\":%d,"
+             "\"min\":%.3f,\"median\":%.3f,\"mean\":%.3f,\"stddev\":%.3f,"
+             "\"mad\":%.3f,\"ci95_lo\":%.3f,\"ci95_hi\":%.3f,\"max\":%.3f,"
+             "\"allocs_per_op\":%.3f}",
+             FIRMWARE_VERSION, BENCH_TARGET, k.name, BENCH_UNIT,
+             (unsigned)iters, samples, st.min, st.median, st.mean,
+             st.stddev, st.mad, st.ciLo, st.ciHi, st.max, allocsPerOp);
+    emit(line);
+    ran++;
+  }
+  return ran;
+}
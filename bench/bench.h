@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// MICROBENCHMARK HARNESS
+// ---------------------------
+// Same kernels on the native build (timed in ns with CLOCK_MONOTONIC)
+// and on the ESP32-S3 (timed in CPU cycles). Each kernel is run in
+// batches sized so one sample spans BENCH_SAMPLE_TICKS; per-op cost is
+// reported as min / median / mean / stddev / MAD plus a 95% confidence
+// interval of the median, one JSON object per line.
+
+#ifdef ARDUINO
+#define BENCH_TARGET       "esp32s3"
+#define BENCH_UNIT         "cycles"
+#define BENCH_SAMPLE_TICKS 240000     // ~1 ms at 240 MHz
+#define BENCH_SAMPLES      21
+#else
+#define BENCH_TARGET       "native"
+#define BENCH_UNIT         "ns"
+#define BENCH_SAMPLE_TICKS 200000     // 200 us
+#define BENCH_SAMPLES      41
+#endif
+
+#define BENCH_WARMUP       3
+#define BENCH_LINE_MAX     512
+
+struct BenchKernel {
+  const char* name;
+  void (*run)(uint32_t iters);
+};
+
+struct BenchOptions {
+  const char* filter  = nullptr;   // substring match on kernel name
+  int         samples = BENCH_SAMPLES;
+};
+
+// Receives one complete JSON line (no trailing newline).
+typedef void (*BenchEmit)(const char* line);
+
+extern const BenchKernel benchKernels[];
+extern const size_t benchKernelCount;
+
+// Returns the number of kernels run.
+int benchRunAll(const BenchOptions& opt, BenchEmit emit);
+
+// Keeps the compiler from discarding a computed value.
+template <typename T>
+inline void benchKeep(const T& value) {
+  asm volatile("" : : "r"(&value) : "memory");
+}
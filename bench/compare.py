@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+"""Compare two bench result files (JSON lines) kernel by kernel.
+
+    bench/compare.py base.jsonl new.jsonl [--threshold 5]
+
+A kernel is flagged as a regression when its median got slower by more
+than --threshold percent AND the 95% confidence intervals of the two
+medians do not overlap. Exits 1 if any regression is found.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{"bench"'):
+                continue   # serial monitor noise
+            r = json.loads(line)
+            results[(r["target"], r["kernel"])] = r
+    return results
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("base")
+    ap.add_argument("new")
+    ap.add_argument("--threshold", type=float, default=5.0)
+    args = ap.parse_args()
+
+    base, new = load(args.base), load(args.new)
+    regressions = 0
+
+    print(f"{'target':8} {'kernel':24} {'base':>10} {'new':>10} {'delta':>8}")
+    for key in sorted(base.keys() & new.keys()):
+        b, n = base[key], new[key]
+        delta = 100.0 * (n["median"] - b["median"]) / b["median"]
+        slower = delta > args.threshold and n["ci95_lo"] > b["ci95_hi"]
+        faster = delta < -args.threshold and n["ci95_hi"] < b["ci95_lo"]
+        mark = "REGRESSION" if slower else ("faster" if faster else "")
+        regressions += slower
+        print(f"{key[0]:8} {key[1]:24} {b['median']:10.2f} {n['median']:10.2f} "
+              f"{delta:+7.1f}% {mark}")
+
+    for key in sorted(base.keys() - new.keys()):
+        print(f"{key[0]:8} {key[1]:24} missing from {args.new}")
+
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
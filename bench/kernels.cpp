@@ -0,0 +1,647 @@
+#include <string.h>
+
+#include "bench.h"
+#include "camera_link.h"
+#include "camera_control.h"
+#include "capture_format.h"
+#include "commands.h"
+#include "event_bus.h"
+#include "hit_packet.h"
+#include "hit_pipeline.h"
+#include "hmac_sha256.h"
+#include "json_out.h"
+#include "lora_rate.h"
+#include "lora_sync.h"
+#include "match_auth.h"
+#include "match_record.h"
+#include "pools.h"
+#include "spsc_queue.h"
+#include "stall_profiler.h"
+#include "telemetry_codec.h"
+#include "version.h"
+
+// ---------------------------
+// CAMERA LINE PARSING
+// ---------------------------
+// One iteration = one camera line, mixing hits with other traffic.
+static const char camStream[] =
+    "HIT\r\n"
+    "  HIT\n"
+    "BLOB 120 88 14\n"
+    "\n"
+    "HIT\n";
+
+static void benchCameraFeed(uint32_t iters) {
+  static CameraLineReader reader;
+  uint32_t hits = 0;
+  size_t pos = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    while (true) {
+      uint8_t c = (uint8_t)camStream[pos];
+      if (++pos == sizeof(camStream) - 1) pos = 0;
+      if (reader.feed(c)) {
+        if (parseCameraLine(reader.line(), reader.length()) == CAM_MSG_HIT) hits++;
+        break;
+      }
+    }
+  }
+  benchKeep(hits);
+}
+
+static void benchCameraClassify(uint32_t iters) {
+  static const char* lines[] = { "HIT", "BLOB 120 88 14", "HIX", "HB 30" };
+  uint32_t hits = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    const char* l = lines[i & 3];
+    benchKeep(l);
+    if (parseCameraLine(l, strlen(l)) == CAM_MSG_HIT) hits++;
+  }
+  benchKeep(hits);
+}
+
+// One iteration = one camera line through the full pipeline.
+static void onBenchHit(const HitEvent& hit) {
+  benchKeep(hit);
+}
+
+static void benchHitPipeline(uint32_t iters) {
+  static HitPipeline pipeline;
+  static size_t pos = 0;
+  pipeline.setSink(onBenchHit);
+
+  const uint8_t* bytes = (const uint8_t*)camStream;
+  size_t total = sizeof(camStream) - 1;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    uint32_t before = pipeline.camLines;
+    while (pipeline.camLines == before) {
+      pipeline.feedCamera(bytes + pos, 1, i);
+      if (++pos == total) pos = 0;
+    }
+  }
+}
+
+// ---------------------------
+// COMMAND DISPATCH
+// ---------------------------
+static void benchCommandDispatch(uint32_t iters) {
+  static const char* msgs[] = { "MATCH_START", "MATCH_END", " MATCH_END\r\n", "PING" };
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    const char* m = msgs[i & 3];
+    benchKeep(m);
+    acc += (uint32_t)parseCommand(m, strlen(m));
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// SERIALIZATION
+// ---------------------------
+// The /metrics body without the heap section.
+static void benchMetricsJson(uint32_t iters) {
+  char buf[512];
+  size_t total = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    JsonOut j(buf, sizeof(buf));
+    j.beginObject();
+    j.field("uptime_ms", i * 20);
+    j.field("hits", i / 8);
+    j.field("hits_ignored", i / 64);
+    j.field("cam_lines", i);
+    j.field("cam_unknown", i / 3);
+    j.field("cam_overflows", (uint32_t)0);
+    j.endObject();
+    total += j.finish();
+    benchKeep(buf);
+  }
+  benchKeep(total);
+}
+
+static void benchHitEncode(uint32_t iters) {
+  uint8_t buf[HIT_PACKET_SIZE];
+  HitPacket pkt = { HIT_PACKET_HIT, 7, 0xBEEF, 0, 0, 0, 3 };
+
+  for (uint32_t i = 0; i < iters; i++) {
+    pkt.seq = i;
+    pkt.timeMs = i * 20;
+    encodeHitPacket(pkt, buf);
+    benchKeep(buf);
+  }
+}
+
+static void benchHitDecode(uint32_t iters) {
+  uint8_t buf[HIT_PACKET_SIZE];
+  HitPacket pkt = { HIT_PACKET_HIT, 7, 0xBEEF, 42, 840, 1, 3 };
+  encodeHitPacket(pkt, buf);
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    benchKeep(buf);
+    if (decodeHitPacket(buf, sizeof(buf), pkt)) acc += pkt.seq;
+  }
+  benchKeep(acc);
+}
+
+// Three copies per hit, eight planes interleaved.
+static void benchHitDedup(uint32_t iters) {
+  static HitReceiver receiver;
+  static uint32_t seq = 0;
+  HitPacket pkt = { HIT_PACKET_HIT, 0, 1, 0, 0, 0, 3 };
+  uint32_t fresh = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    uint32_t n = seq++;
+    pkt.planeId = (uint16_t)(n & 7);
+    pkt.seq = (n >> 3) / 3;
+    pkt.copy = (uint8_t)((n >> 3) % 3);
+    if (receiver.accept(pkt)) fresh++;
+  }
+  benchKeep(fresh);
+}
+
+// Typical record: RSSI, CPU, loop stats and heap move, counters mostly don't.
+static void fillTelemetry(TelemetrySample& s, uint32_t i) {
+  s.timeMs = i * 1000;
+  s.values[TELEM_RSSI_DBM] = -60 - (int32_t)(i % 5);
+  s.values[TELEM_CPU0_PCT] = 20 + (int32_t)(i % 7);
+  s.values[TELEM_CPU1_PCT] = 35 + (int32_t)(i % 3);
+  s.values[TELEM_LOOP_PERIOD_US] = 20100 + (int32_t)(i % 40);
+  s.values[TELEM_LOOP_JITTER_US] = 80 + (int32_t)(i % 11);
+  s.values[TELEM_HEAP_FREE] = 210000 - (int32_t)(i % 64) * 16;
+  s.values[TELEM_HITS] = (int32_t)(i / 8);
+}
+
+static void benchTelemetryEncode(uint32_t iters) {
+  static TelemetryEncoder enc;
+  static TelemetrySample s = {};
+  uint8_t buf[TELEM_RECORD_MAX];
+  size_t total = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    fillTelemetry(s, i);
+    total += enc.encode(s, buf, sizeof(buf));
+    benchKeep(buf);
+  }
+  benchKeep(total);
+}
+
+static void benchTelemetryDecode(uint32_t iters) {
+  static uint8_t records[64][TELEM_RECORD_MAX];
+  static size_t lens[64];
+  static bool built = false;
+
+  if (!built) {
+    TelemetryEncoder enc;
+    TelemetrySample s = {};
+    for (uint32_t i = 0; i < 64; i++) {
+      if (i % TELEM_KEYFRAME_EVERY == 0) enc.forceKeyframe();
+      fillTelemetry(s, i);
+      lens[i] = enc.encode(s, records[i], TELEM_RECORD_MAX);
+    }
+    built = true;
+  }
+
+  TelemetryDecoder dec;
+  TelemetrySample out;
+  uint32_t ok = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    uint32_t r = i & 63;
+    if (r == 0) dec = TelemetryDecoder();
+    if (dec.decode(records[r], lens[r], out)) ok++;
+  }
+  benchKeep(ok);
+}
+
+// ---------------------------
+// PROFILING OVERHEAD
+// ---------------------------
+// One loop() pass as instrumented in the firmware: begin, 3 stages, end.
+static void benchProfilerPass(uint32_t iters) {
+  static const char* const stages[] = { "other", "camera", "broadcast", "log", "telemetry" };
+  static StallProfiler profiler(5000);
+  static int task = profiler.addTask("loop", stages, 5, 100000);
+  uint32_t now = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    profiler.begin(task, now);
+    profiler.stage(task, 1, now + 3);
+    profiler.stage(task, 4, now + 40);
+    now += 50;
+    profiler.end(task, now, now / 1000);
+    now += 20000;
+  }
+  benchKeep(now);
+}
+
+// ---------------------------
+// CAMERA CONTROL
+// ---------------------------
+// One iteration = one heartbeat line through the pipeline into
+// CameraControl, plus the poll() that follows it in loop().
+static CameraControl* benchCamera = nullptr;
+
+static void onBenchHeartbeat(uint8_t cam, const CameraHealth& h, uint32_t nowMs) {
+  (void)cam;
+  benchCamera->onHeartbeat(h, nowMs);
+}
+
+static void benchCameraHeartbeat(uint32_t iters) {
+  static const char hb[] = "HB 3 912 415 7\n";
+  static const CameraConfig cfg = { true, { 80, 60, 160, 120 }, 0, 240, 12 };
+  static CameraControl control(cfg, 250, 1000, 500);
+  static HitPipeline pipeline;
+  char line[CAMERA_CONTROL_LINE_MAX];
+  uint32_t now = 0;
+  size_t acc = 0;
+
+  benchCamera = &control;
+  pipeline.setHeartbeatSink(onBenchHeartbeat);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    now += 20;
+    pipeline.feedCamera((const uint8_t*)hb, sizeof(hb) - 1, now);
+    while (size_t n = control.poll(now, line, sizeof(line))) acc += n;
+  }
+  benchKeep((uint32_t)acc);
+}
+
+// ---------------------------
+// TWO-CAMERA MERGE
+// ---------------------------
+// One iteration = one loop() pass with a hit on the nose camera, the tail
+// camera seeing the same shot 8 ms later every other pass, and the merge
+// released behind both.
+static void benchCameraMerge(uint32_t iters) {
+  static const uint8_t hit[] = { 'H', 'I', 'T', '\n' };
+  static HitPipeline pipeline;
+  uint64_t now = 0;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    now += 20000;
+    if (i & 1) pipeline.feedCamera(1, hit, sizeof(hit), now - 12000);
+    pipeline.feedCamera(0, hit, sizeof(hit), now - 20000);
+    acc += pipeline.releaseHits(now - 500);
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// CAMERA CAPTURE
+// ---------------------------
+// One iteration = append one UART read (camStream) to the capture ring,
+// what loop() pays per read while recording, with the flusher's drain.
+static void benchCaptureAppend(uint32_t iters) {
+  static uint8_t storage[4096];
+  static CaptureRing ring(storage, sizeof(storage));
+  uint8_t drain[256];
+  uint32_t now = 0;
+  size_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    now += 3000;
+    ring.append(now, CAPTURE_BYTES, 0, (const uint8_t*)camStream, sizeof(camStream) - 1);
+    if ((i & 3) == 3) acc += ring.read(drain, sizeof(drain));
+  }
+  benchKeep((uint32_t)acc);
+}
+
+// ---------------------------
+// LORA RATE
+// ---------------------------
+// One iteration = what the ground does per uplink frame: decode, update
+// the controller, decide, and run the sync state machine.
+static void benchLoraLink(uint32_t iters) {
+  static LoraRateController ctl;
+  static LoraRateSync ground(LORA_ROLE_GROUND, 1, 2);
+  LoraFrame f = LoraFrame(), in, out;
+  uint8_t buf[LORA_FRAME_MAX];
+  uint32_t now = 0, acc = 0;
+
+  f.type = LORA_FRAME_HIT;
+  f.planeId = 1;
+  f.rate = 2;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    now += 50;
+    f.linkSeq = (uint16_t)(i + (i >> 4));   // some gaps
+    f.hitSeq = i;
+    size_t n = encodeLoraFrame(f, buf);
+    if (!decodeLoraFrame(buf, n, in)) continue;
+
+    ctl.onReceived(in.linkSeq, (float)(i & 15) - 4.0f, -110.0f, in.rate, now);
+    acc += (uint32_t)ctl.decide(ground.rate(), now);
+    ground.onFrame(in, now);
+    if (ground.poll(now, out)) acc += out.linkSeq;
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// AUTHENTICATION
+// ---------------------------
+// HMAC-SHA256 with precomputed pad states. "hmac_*" uses the default
+// backend (the SHA peripheral on the ESP32, software on native),
+// "*_sw" always software. hit = one signed "HIT <seq> <timeMs>" body.
+static const char authHitBody[] = "HIT 4294967 123456789";
+
+static void benchHmac(uint32_t iters, HmacBackend backend, size_t len) {
+  static uint8_t msg[1024];
+  static HmacSha256 key;
+  if (!key.hasKey()) key.setKey((const uint8_t*)"bench key", 9);
+  key.setBackend(backend);
+
+  const uint8_t* data = len ? msg : (const uint8_t*)authHitBody;
+  size_t n = len ? len : sizeof(authHitBody) - 1;
+  uint8_t out[SHA256_BYTES];
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    msg[0] = (uint8_t)i;
+    key.mac(data, n, out);
+    acc += out[0];
+  }
+  benchKeep(acc);
+}
+
+static void benchHmacHit(uint32_t iters)   { benchHmac(iters, HMAC_DEFAULT_BACKEND, 0); }
+static void benchHmacHitSw(uint32_t iters) { benchHmac(iters, HMAC_SOFTWARE, 0); }
+static void benchHmac1k(uint32_t iters)    { benchHmac(iters, HMAC_DEFAULT_BACKEND, 1024); }
+static void benchHmac1kSw(uint32_t iters)  { benchHmac(iters, HMAC_SOFTWARE, 1024); }
+
+// One iteration = what broadcastHit pays: format + sign the WS frame
+// and tag the UDP packet.
+static void benchAuthSignHit(uint32_t iters) {
+  static MatchAuth auth;
+  static HmacSha256 planeKey;
+  static bool started = false;
+  if (!started) {
+    started = true;
+    auth.begin("bench secret", 1, 1);
+    authPlaneKey(planeKey, "bench secret", 1);
+
+    char line[AUTH_LINE_MAX];
+    size_t n = authSignMatchStart(planeKey, 2, auth.challenge(), line, sizeof(line));
+    PhoneCommand cmd;
+    auth.verifyCommand(line, n, cmd, 3);
+  }
+
+  HitPacket pkt = { HIT_PACKET_HIT, 1, 7, 0, 0, 0, 3 };
+  uint8_t buf[HIT_PACKET_SIZE], tag[HIT_PACKET_TAG];
+  char frame[64];
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    acc += (uint32_t)auth.signHit(i, i * 20, frame, sizeof(frame));
+    pkt.seq = i;
+    encodeHitPacket(pkt, buf);
+    auth.tagPacket(buf, tag);
+    acc += tag[0];
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// QUEUES
+// ---------------------------
+static void benchSpscPushPop(uint32_t iters) {
+  static SpscQueue<uint32_t, 64> q;
+  uint32_t acc = 0, v;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    q.push(i);
+    if (q.pop(v)) acc += v;
+  }
+  benchKeep(acc);
+}
+
+// One iteration = 16 pushes followed by 16 pops.
+static void benchSpscBurst(uint32_t iters) {
+  static SpscQueue<HitPacket, 32> q;
+  HitPacket pkt = { HIT_PACKET_HIT, 7, 1, 0, 0, 0, 1 };
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    for (uint32_t j = 0; j < 16; j++) {
+      pkt.seq = j;
+      q.push(pkt);
+    }
+    HitPacket out;
+    while (q.pop(out)) acc += out.seq;
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// POOLS
+// ---------------------------
+// One iteration = one uncontended acquire + release (both CASes).
+static void benchPoolCycle(uint32_t iters) {
+  static ObjectPool<RadioPacket, 8> pool;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    RadioPacket* p = pool.acquire();
+    p->pkt.seq = i;
+    acc += p->pkt.seq;
+    pool.release(p);
+  }
+  benchKeep(acc);
+}
+
+// One iteration = a signed command through the AsyncTCP -> loop() handoff:
+// copy into a pooled buffer, queue, dequeue, release.
+static void benchPoolCommand(uint32_t iters) {
+  static const char cmd[] = "MATCH_END 42 00112233445566778899aabbccddeeff";
+  static SpscQueue<CommandBuffer*, POOL_COMMANDS> q;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    q.push(poolCommand(cmd, sizeof(cmd) - 1));
+    CommandBuffer* c;
+    if (q.pop(c)) {
+      acc += c->len;
+      commandPool.release(c);
+    }
+  }
+  benchKeep(acc);
+}
+
+// ---------------------------
+// EVENT BUS
+// ---------------------------
+// One iteration = one hit to four sinks shaped like broadcastHit's: an
+// encode, two counters and a queue. "bus_direct" calls them by hand,
+// "bus_publish" through EventBus, "bus_fnptr" through a runtime table
+// of function pointers (what a registry would do), "bus_async" with
+// the last sink behind an AsyncSubscriber drained every 8 hits.
+static uint8_t  busPacket[HIT_PACKET_SIZE];
+static uint32_t busCount = 0;
+static uint32_t busLast = 0;
+static SpscQueue<HitEvent, 16> busQueue;
+
+static void busEncode(const HitEvent& h) {
+  HitPacket pkt = { HIT_PACKET_HIT, 1, 1, h.seq, h.timeMs, 0, 3 };
+  encodeHitPacket(pkt, busPacket);
+}
+static void busCounter(const HitEvent&) { busCount++; }
+static void busRemember(const HitEvent& h) { busLast = h.seq; }
+static void busQueueHit(const HitEvent& h) {
+  HitEvent out;
+  busQueue.push(h);
+  busQueue.pop(out);
+}
+
+typedef EventBus<HitEvent, busEncode, busCounter, busRemember, busQueueHit> BenchBus;
+typedef AsyncSubscriber<HitEvent, busRemember, 8> BenchLater;
+typedef EventBus<HitEvent, busEncode, busCounter, busQueueHit, BenchLater::deliver> BenchAsyncBus;
+
+static void benchBusDirect(uint32_t iters) {
+  for (uint32_t i = 0; i < iters; i++) {
+    HitEvent h = { i, i * 20 };
+    busEncode(h);
+    busCounter(h);
+    busRemember(h);
+    busQueueHit(h);
+  }
+  benchKeep(busPacket[8] + busCount + busLast);
+}
+
+static void benchBusPublish(uint32_t iters) {
+  for (uint32_t i = 0; i < iters; i++) {
+    HitEvent h = { i, i * 20 };
+    BenchBus::publish(h);
+  }
+  benchKeep(busPacket[8] + busCount + busLast);
+}
+
+static void benchBusFnptr(uint32_t iters) {
+  static HitSink volatile table[] = { busEncode, busCounter, busRemember, busQueueHit };
+  for (uint32_t i = 0; i < iters; i++) {
+    HitEvent h = { i, i * 20 };
+    for (HitSink s : table) s(h);
+  }
+  benchKeep(busPacket[8] + busCount + busLast);
+}
+
+static void benchBusAsync(uint32_t iters) {
+  for (uint32_t i = 0; i < iters; i++) {
+    HitEvent h = { i, i * 20 };
+    BenchAsyncBus::publish(h);
+    if ((i & 7) == 7) BenchLater::drain();
+  }
+  BenchLater::drain();
+  benchKeep(busPacket[8] + busCount + busLast);
+}
+
+// ---------------------------
+// MATCH RECORD SYNC
+// ---------------------------
+// A record one match deep (start + 200 hits, ~1.5 s apart); each
+// iteration is one phone catching up on the last 8 entries: "append"
+// adds one hit, "encode" takes the delta and encodes it (what SYNC N
+// costs loop()), "decode" is the phone side, "json" is /match?since=N.
+static MatchRecord benchRecord(0x5eed);
+static uint8_t  benchDelta[MATCH_DELTA_BYTES_MAX];
+static size_t   benchDeltaLen = 0;
+
+static void fillBenchRecord() {
+  if (benchRecord.head() > 0) return;
+  benchRecord.start(60000);
+  for (uint32_t i = 1; i <= 200; i++) benchRecord.hit(i, 60000 + i * 1500);
+
+  MatchDelta d;
+  benchRecord.delta(benchRecord.head() - 8, d);
+  benchDeltaLen = encodeMatchDelta(d, benchDelta, sizeof(benchDelta));
+}
+
+static void benchMatchAppend(uint32_t iters) {
+  static MatchRecord r;
+  r.start(0);
+  for (uint32_t i = 0; i < iters; i++) r.hit(i, i * 1500);
+  benchKeep(r.head());
+}
+
+static void benchMatchDeltaEncode(uint32_t iters) {
+  fillBenchRecord();
+  uint8_t out[MATCH_DELTA_BYTES_MAX];
+  MatchDelta d;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    benchRecord.delta(benchRecord.head() - 8, d);
+    acc += (uint32_t)encodeMatchDelta(d, out, sizeof(out));
+  }
+  benchKeep(acc);
+}
+
+static void benchMatchDeltaDecode(uint32_t iters) {
+  fillBenchRecord();
+  MatchDelta d;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    if (decodeMatchDelta(benchDelta, benchDeltaLen, d)) acc += d.to;
+  }
+  benchKeep(acc);
+}
+
+static void benchMatchDeltaJson(uint32_t iters) {
+  fillBenchRecord();
+  char json[1024];
+  MatchDelta d;
+  uint32_t acc = 0;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    benchRecord.delta(benchRecord.head() - 8, d);
+    JsonOut j(json, sizeof(json));
+    j.beginObject();
+    writeMatchDeltaJson(j, d);
+    j.endObject();
+    acc += (uint32_t)j.finish();
+  }
+  benchKeep(acc);
+}
+
+const BenchKernel benchKernels[] = {
+  { "camera_line_feed",     benchCameraFeed },
+  { "camera_line_classify", benchCameraClassify },
+  { "hit_pipeline_line",    benchHitPipeline },
+  { "command_dispatch",     benchCommandDispatch },
+  { "metrics_json_write",   benchMetricsJson },
+  { "hit_packet_encode",    benchHitEncode },
+  { "hit_packet_decode",    benchHitDecode },
+  { "hit_receiver_dedup",   benchHitDedup },
+  { "telemetry_encode",     benchTelemetryEncode },
+  { "telemetry_decode",     benchTelemetryDecode },
+  { "profiler_loop_pass",   benchProfilerPass },
+  { "camera_heartbeat",     benchCameraHeartbeat },
+  { "camera_merge2",        benchCameraMerge },
+  { "capture_append",       benchCaptureAppend },
+  { "lora_link",            benchLoraLink },
+  { "hmac_hit",             benchHmacHit },
+  { "hmac_hit_sw",          benchHmacHitSw },
+  { "hmac_1k",              benchHmac1k },
+  { "hmac_1k_sw",           benchHmac1kSw },
+  { "auth_sign_hit",        benchAuthSignHit },
+  { "spsc_push_pop",        benchSpscPushPop },
+  { "spsc_burst16",         benchSpscBurst },
+  { "pool_cycle",           benchPoolCycle },
+  { "pool_command",         benchPoolCommand },
+  { "bus_direct",           benchBusDirect },
+  { "bus_publish",          benchBusPublish },
+  { "bus_fnptr",            benchBusFnptr },
+  { "bus_async",            benchBusAsync },
+  { "match_append",         benchMatchAppend },
+  { "match_delta_encode",   benchMatchDeltaEncode },
+  { "match_delta_decode",   benchMatchDeltaDecode },
+  { "match_delta_json",     benchMatchDeltaJson },
+};
+
+const size_t benchKernelCount = sizeof(benchKernels) / sizeof(benchKernels[0]);
@@ -0,0 +1,61 @@
+#include "bench.h"
+
+// ---------------------------
+// BENCH ENTRY POINTS
+// ---------------------------
+// native_bench : ./program [--filter NAME] [--samples N] > results.jsonl
+//                ./program --alloc-guard   (exit 1 if the hit path allocates)
+//                ./program --auth-check    (exit 1 if a command is misjudged)
+// heltec_bench : results are printed on the serial monitor, one JSON
+//                line per kernel, followed by "BENCH_DONE".
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+static void emitSerial(const char* line) {
+  Serial.println(line);
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);   // let USB CDC enumerate
+
+  Serial.printf("# aeroduel bench, %u MHz\n", (unsigned)ESP.getCpuFreqMHz());
+  BenchOptions opt;
+  benchRunAll(opt, emitSerial);
+  Serial.println("BENCH_DONE");
+}
+
+void loop() {
+  delay(1000);
+}
+
+#else
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "alloc_guard.h"
+#include "auth_check.h"
+
+static void emitStdout(const char* line) {
+  puts(line);
+  fflush(stdout);
+}
+
+int main(int argc, char** argv) {
+  BenchOptions opt;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--filter") && i + 1 < argc) opt.filter = argv[++i];
+    else if (!strcmp(argv[i], "--samples") && i + 1 < argc) opt.samples = atoi(argv[++i]);
+    else if (!strcmp(argv[i], "--alloc-guard")) return runAllocGuard(10000);
+    else if (!strcmp(argv[i], "--auth-check")) return runAuthCheck();
+    else {
+      fprintf(stderr, "usage: %s [--filter NAME] [--samples N] | --alloc-guard | --auth-check\n", argv[0]);
+      return 2;
+    }
+  }
+
+  return benchRunAll(opt, emitStdout) > 0 ? 0 : 1;
+}
+#endif
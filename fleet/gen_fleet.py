@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""Generate plane identities from fleet/fleet.json.
+
+Outputs (both committed, regenerate after editing the manifest):
+  include/fleet_manifest.h   constexpr table of every plane
+  fleet/planes.ini           one PlatformIO env per plane (PLANE_ID=<id>)
+
+    python3 fleet/gen_fleet.py                write both files
+    pio run $(python3 fleet/gen_fleet.py --pio-args)   build the fleet
+
+Also runs as a PlatformIO pre: script; it refreshes the header and stops
+the build if planes.ini was stale (envs are read before scripts run).
+"""
+import json
+import os
+import re
+import sys
+
+STATUSES = ["ready", "in_match"]   # must match planeStatus()
+
+
+try:
+    Import("env")  # noqa: F821 (defined when run by SCons)
+    IN_PIO = True
+except NameError:
+    IN_PIO = False
+
+
+def project_dir():
+    if IN_PIO:
+        return env.subst("$PROJECT_DIR")  # noqa: F821
+    return os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def hostname(name):
+    return re.sub(r"[^a-z0-9-]", "", name.lower())
+
+
+def c_str(s):
+    return json.dumps(s, ensure_ascii=False)
+
+
+def load(root):
+    with open(os.path.join(root, "fleet", "fleet.json")) as f:
+        manifest = json.load(f)
+
+    defaults = manifest.get("defaults", {})
+    planes, ids, hosts = [], set(), set()
+    for p in manifest["planes"]:
+        plane = {"model": defaults.get("model", "F22")}
+        plane.update(p)
+        plane["lora"] = dict(defaults.get("lora", {}), **p.get("lora", {}))
+        plane["hostname"] = p.get("hostname", hostname(p["name"]))
+
+        if not 1 <= plane["id"] <= 0xFFFF:
+            sys.exit(f"fleet.json: {p['name']}: id must be 1..65535")
+        if plane["id"] in ids or plane["hostname"] in hosts:
+            sys.exit(f"fleet.json: {p['name']}: duplicate id or hostname")
+        ids.add(plane["id"])
+        hosts.add(plane["hostname"])
+        planes.append(plane)
+    return planes
+
+
+def id_json(plane, status):
+    # FIRMWARE_VERSION is spliced in by the compiler.
+    head = json.dumps({"name": plane["name"], "model": plane["model"],
+                       "id": plane["id"]}, ensure_ascii=False,
+                      separators=(",", ":"))[:-1]
+    tail = '","status":"' + status + '"}'
+    return c_str(head + ',"fw":"') + " FIRMWARE_VERSION " + c_str(tail)
+
+
+def header(planes):
+    out = [
+        "#pragma once",
+        "",
+        "// GENERATED by fleet/gen_fleet.py from fleet/fleet.json - do not edit.",
+        "",
+        "#include \"plane_identity_types.h\"",
+        "#include \"version.h\"",
+        "",
+        "constexpr PlaneIdentity kFleet[] = {",
+    ]
+    for p in planes:
+        lora = p["lora"]
+        out += [
+            "  {",
+            f"    {p['id']}, {c_str(p['name'])}, {c_str(p['hostname'])}, {c_str(p['model'])},",
+        ]
+        out += [f"    {id_json(p, s)}," for s in STATUSES]
+        out += [
+            f"    {{ {lora['freq_hz']}u, {lora['sf']}, {lora['bw_hz']}u, {lora['cr']}, "
+            f"0x{lora['sync_word']:02X}, {lora['tx_power_dbm']} }},",
+            "  },",
+        ]
+    out += ["};", "", f"constexpr size_t kFleetSize = {len(planes)};", ""]
+    return "\n".join(out)
+
+
+def env_name(p):
+    return "plane_" + p["hostname"].replace("-", "_")
+
+
+def ini(planes):
+    out = ["; GENERATED by fleet/gen_fleet.py from fleet/fleet.json - do not edit.", ""]
+    for p in planes:
+        out += [
+            f"[env:{env_name(p)}]",
+            "extends = env:heltec_lora_v4",
+            "build_flags =",
+            "    ${env:heltec_lora_v4.build_flags}",
+            f"    -D PLANE_ID={p['id']}",
+        ]
+        if "upload_port" in p:
+            out.append(f"upload_port = {p['upload_port']}")
+        out.append("")
+    return "\n".join(out)
+
+
+def write_if_changed(path, text):
+    try:
+        with open(path) as f:
+            if f.read() == text:
+                return False
+    except FileNotFoundError:
+        pass
+    with open(path, "w") as f:
+        f.write(text)
+    return True
+
+
+def generate(root):
+    planes = load(root)
+    write_if_changed(os.path.join(root, "include", "fleet_manifest.h"), header(planes))
+    return write_if_changed(os.path.join(root, "fleet", "planes.ini"), ini(planes)), planes
+
+
+if IN_PIO:
+    ini_changed, _ = generate(project_dir())
+    if ini_changed:
+        print("fleet/planes.ini was out of date and has been regenerated; run pio again")
+        env.Exit(1)  # noqa: F821
+elif __name__ == "__main__":
+    root = project_dir()
+    if "--pio-args" in sys.argv:
+        print(" ".join(f"-e {env_name(p)}" for p in load(root)))
+    else:
+        generate(root)
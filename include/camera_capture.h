@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class AsyncWebServer;
+
+// ---------------------------
+// CAMERA CAPTURE
+// ---------------------------
+// Records the raw camera UART streams to LittleFS (capture_format.h) so a
+// real match can be replayed bit-for-bit through HitPipeline on a laptop
+// (tools/replay). loop() only copies bytes into a RAM ring; a low
+// priority task on core 0 writes the ring to flash, so a slow flash page
+// erase never delays a hit. If the ring fills anyway the record is
+// dropped and counted, never blocked on.
+//
+//   POST /capture/start, POST /capture/stop
+//   GET  /capture/status
+//   GET  /capture          download (409 while recording)
+
+#ifndef CAPTURE_ENABLED
+#define CAPTURE_ENABLED 1
+#endif
+
+#ifndef CAPTURE_RING_BYTES
+#define CAPTURE_RING_BYTES 16384
+#endif
+
+#ifndef CAPTURE_MAX_FILE_BYTES
+#define CAPTURE_MAX_FILE_BYTES (1024UL * 1024UL)
+#endif
+
+// 1 = start recording on MATCH_START and stop on MATCH_END
+#ifndef CAPTURE_DURING_MATCH
+#define CAPTURE_DURING_MATCH 1
+#endif
+
+#define CAPTURE_PATH "/capture.bin"
+
+void captureBegin(AsyncWebServer& server, uint16_t planeId);
+
+// Any task.
+void captureRequest(bool on);
+
+// loop() only: applies start / stop requests and records match edges.
+void capturePoll(bool matchActive, uint32_t nowUs);
+
+// loop() only: bytes exactly as read from camera cam's UART.
+void captureCamera(uint8_t cam, const uint8_t* data, size_t len, uint32_t nowUs);
+
+// loop() only: HitPipeline::releaseHits(cutoffUs) changed the merge.
+void captureRelease(uint32_t cutoffUs);
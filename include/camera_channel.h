@@ -0,0 +1,68 @@
+#pragma once
+
+#include <stdint.h>
+#include "camera_link.h"
+#include "json_out.h"
+
+class AsyncWebServer;
+
+// ---------------------------
+// CAMERA CHANNEL
+// ---------------------------
+// Firmware side of CameraControl, one per camera (camera_inputs.h):
+// writes CFG / PING lines to each H7 on its own UART TX, takes each
+// camera's heartbeats from the hit pipeline, and follows the match state
+// so the cameras idle between matches.
+//
+//   GET  /camera   cam=N  health + current config
+//   POST /camera   cam=N  roi=x,y,w,h  exposure_us=N  threshold=N  min_blob_px=N
+//                  (any subset; applied on the next loop() pass)
+//
+// cam defaults to 0, the nose camera.
+
+#ifndef CAMERA_PING_MS
+#define CAMERA_PING_MS 250
+#endif
+
+// Dead camera is reported at most this long (+ one loop pass) after its
+// last heartbeat.
+#ifndef CAMERA_HB_TIMEOUT_MS
+#define CAMERA_HB_TIMEOUT_MS 1000
+#endif
+
+#ifndef CAMERA_CFG_RETRY_MS
+#define CAMERA_CFG_RETRY_MS 500
+#endif
+
+// Boot-time config. ROI defaults to the full QVGA frame; narrow it
+// during a match for a higher frame rate.
+#ifndef CAMERA_ROI
+#define CAMERA_ROI 0, 0, 320, 240
+#endif
+
+#ifndef CAMERA_EXPOSURE_US
+#define CAMERA_EXPOSURE_US 0          // auto
+#endif
+
+#ifndef CAMERA_THRESHOLD
+#define CAMERA_THRESHOLD 240
+#endif
+
+#ifndef CAMERA_MIN_BLOB_PX
+#define CAMERA_MIN_BLOB_PX 12
+#endif
+
+// match is the plane's state at boot (the pipeline's), so the cameras start
+// out agreeing with /id and mDNS.
+void cameraChannelBegin(AsyncWebServer& server, bool match);
+
+// loop() only
+void cameraChannelSetMatch(bool match);
+void cameraChannelPoll(uint32_t nowMs);
+
+// HitPipeline heartbeat sink (loop()).
+void cameraChannelHeartbeat(uint8_t cam, const CameraHealth& health, uint32_t nowMs);
+
+// "camera": [...] for /metrics, one entry per camera, inside an open
+// object.
+void cameraChannelWriteJson(JsonOut& j);
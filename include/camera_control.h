@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camera_link.h"
+#include "json_out.h"
+
+// ---------------------------
+// CAMERA CONTROL CHANNEL (ESP32 -> H7 over CAM_TX)
+// ---------------------------
+// The plane owns the camera's settings and pushes them as one line so
+// the H7 applies them atomically:
+//
+//   CFG <gen> <IDLE|MATCH> <roi_x> <roi_y> <roi_w> <roi_h> <exposure_us> <threshold> <min_blob_px>
+//   PING
+//
+// IDLE lets the H7 stop detecting between matches; in MATCH it crops to
+// the ROI, which is what buys frame rate. Every change bumps gen. The
+// camera answers each PING with a heartbeat carrying the last gen it
+// applied (camera_link.h), so a lost CFG line or a camera reboot (gen
+// back to 0) is repaired by resending until the gens agree.
+//
+// A camera is declared dead once no heartbeat arrived for timeoutMs,
+// so with poll() running every loop() pass, detection takes at most
+// timeoutMs plus one loop period.
+
+#define CAMERA_CONTROL_LINE_MAX 96
+
+struct CameraRoi {
+  uint16_t x, y, w, h;
+};
+
+struct CameraConfig {
+  bool      match;
+  CameraRoi roi;
+  uint32_t  exposureUs;   // 0 = camera auto exposure
+  uint16_t  threshold;
+  uint16_t  minBlobPx;
+};
+
+enum CameraState : uint8_t {
+  CAMERA_UNKNOWN,   // nothing heard yet
+  CAMERA_ALIVE,
+  CAMERA_DEAD,
+};
+
+class CameraControl {
+public:
+  CameraControl(const CameraConfig& initial, uint32_t pingMs, uint32_t timeoutMs,
+                uint32_t retryMs);
+
+  void setMatch(bool match);
+  void setRoi(const CameraRoi& roi);
+  void setExposure(uint32_t exposureUs);
+  void setThresholds(uint16_t threshold, uint16_t minBlobPx);
+  void setConfig(const CameraConfig& c);
+
+  void onHeartbeat(const CameraHealth& h, uint32_t nowMs);
+
+  // Writes the next line to send (with '\n') into out and returns its
+  // length, or 0 when nothing is due. Call until it returns 0.
+  size_t poll(uint32_t nowMs, char* out, size_t cap);
+
+  CameraState state() const { return st; }
+  bool configApplied() const { return st == CAMERA_ALIVE && last.cfgGen == gen; }
+  const CameraConfig& config() const { return cfg; }
+  const CameraHealth& health() const { return last; }
+
+  void writeJson(JsonOut& j, uint32_t nowMs) const;
+
+  uint32_t deaths      = 0;   // ALIVE/UNKNOWN -> DEAD transitions
+  uint32_t revivals    = 0;   // DEAD -> ALIVE
+  uint32_t configsSent = 0;
+  uint32_t pingsSent   = 0;
+
+private:
+  void changed();
+
+  CameraConfig cfg;
+  CameraHealth last = {};
+  CameraState  st = CAMERA_UNKNOWN;
+
+  uint32_t gen = 1;            // camera boots at 0, so the first CFG always goes out
+  uint32_t pingMs, timeoutMs, retryMs;
+  bool     started = false;
+  bool     cfgDue = true;      // gen changed since the last CFG
+  uint32_t startMs = 0;
+  uint32_t lastHeardMs = 0;
+  uint32_t lastPingMs = 0;
+  uint32_t lastCfgMs = 0;
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <stdint.h>
+#include "hit_pipeline.h"
+#include "json_out.h"
+
+// ---------------------------
+// CAMERA INPUTS
+// ---------------------------
+// Camera 0 is the nose camera on Serial2; camera 1 is an optional tail
+// camera on Serial1. Both take control lines on their TX pin
+// (camera_channel.h).
+// Each UART's receive callback runs in the UART driver task, stamps the
+// bytes with esp_timer_get_time() as they arrive and queues them, so a
+// camera's timing does not depend on when loop() gets to it. loop()
+// drains every queue into HitPipeline, then releases hits up to the time
+// the drain started (less CAMERA_MERGE_HOLD_US for bytes stamped but
+// not yet queued) in arrival order, with cross-camera duplicates merged.
+
+#ifndef CAMERA_COUNT
+#define CAMERA_COUNT 2
+#endif
+
+// Nose camera (working)
+#define CAM_RX 16   // ESP32 receives from H7 TX
+#define CAM_TX 17   // ESP32 sends control lines to H7 RX (camera_channel.h)
+
+// Tail camera
+#ifndef CAM2_RX
+#define CAM2_RX 47
+#endif
+#ifndef CAM2_TX
+#define CAM2_TX 48
+#endif
+
+#ifndef CAMERA_MERGE_HOLD_US
+#define CAMERA_MERGE_HOLD_US 500
+#endif
+
+// Arrival-stamped chunks per camera between the UART task and loop().
+#ifndef CAMERA_CHUNK_QUEUE
+#define CAMERA_CHUNK_QUEUE 32
+#endif
+
+#define CAMERA_CHUNK_BYTES 32
+
+class HardwareSerial;
+
+void cameraInputsBegin();
+
+// Camera cam's UART (for control lines), nullptr before cameraInputsBegin().
+HardwareSerial* cameraInputsUart(uint8_t cam);
+
+// loop() only: feeds every camera into the pipeline and releases hits.
+void cameraInputsPoll(HitPipeline& pipeline);
+
+// Arrival-stamped chunks waiting for loop(), all cameras.
+uint32_t cameraInputsPending();
+
+// "cameras": [...] for /metrics, inside an open object.
+void cameraInputsWriteJson(JsonOut& j, const HitPipeline& pipeline);
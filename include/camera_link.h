@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// CAMERA LINE PROTOCOL
+// ---------------------------
+// The H7 sends newline-terminated ASCII lines ("HIT\n"). The reader
+// assembles them byte by byte into a fixed buffer, trimming whitespace
+// and '\r', so the UART can be drained without blocking or allocating.
+//
+// Heartbeats answer the plane's PING (camera_control.h):
+//   HB <cfg_gen> <fps_x10> <temp_x10> <dropped_frames>
+// e.g. "HB 3 912 415 7" = config 3 applied, 91.2 fps, 41.5 C, 7 dropped.
+
+#define CAMERA_LINE_MAX 64
+
+enum CameraMsg {
+  CAM_MSG_NONE,      // empty line
+  CAM_MSG_HIT,
+  CAM_MSG_HEARTBEAT,
+  CAM_MSG_UNKNOWN,
+};
+
+struct CameraHealth {
+  uint32_t cfgGen;      // last config generation the camera applied
+  uint16_t fpsX10;
+  int16_t  tempX10;     // degrees C
+  uint32_t dropped;     // frames, since camera boot
+};
+
+class CameraLineReader {
+public:
+  // Returns true when a complete, non-empty line is available in line().
+  // The line stays valid until the next call to feed().
+  bool feed(uint8_t c);
+
+  const char* line() const { return buf; }
+  size_t length() const { return len; }
+
+  uint32_t overflows = 0;   // lines longer than CAMERA_LINE_MAX, dropped
+
+private:
+  char   buf[CAMERA_LINE_MAX + 1] = {};
+  size_t len = 0;
+  bool   complete = false;
+  bool   discarding = false;
+};
+
+CameraMsg parseCameraLine(const char* line, size_t len);
+
+// Fills h from a CAM_MSG_HEARTBEAT line; false if a field is missing or
+// out of range.
+bool parseCameraHeartbeat(const char* line, size_t len, CameraHealth& h);
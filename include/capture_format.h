@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// ---------------------------
+// CAMERA CAPTURE FORMAT
+// ---------------------------
+// A capture is the raw camera UART byte streams with microsecond arrival
+// times, plus markers for match start / end so replay gates hits the
+// same way the plane did, and for every point where the plane released
+// merged hits, so replay merges cameras the same way too.
+//
+//   header (16 bytes): "ADCAP2", u16 planeId, u32 startMs, u32 reserved
+//   record           : signed varint dtUs (since previous record),
+//                      varint (len << 4 | cam << 2 | kind), len payload bytes
+//
+// Integers in the header are little-endian. Records are in the order the
+// plane handled them, so times can step back (one camera's chunks are
+// drained before the next camera's).
+//
+// Version 1 ("ADCAP1") files hold camera 0 only: unsigned dtUs, tag
+// (len << 2 | kind), and no release records. CaptureReader reads both.
+
+#define CAPTURE_VERSION 2
+#define CAPTURE_HEADER_SIZE 16
+#define CAPTURE_RECORD_OVERHEAD 10   // two varints, worst case
+#define CAPTURE_CAMERAS_MAX 4
+
+enum CaptureKind : uint8_t {
+  CAPTURE_BYTES,         // payload = camera UART bytes
+  CAPTURE_MATCH_START,   // no payload
+  CAPTURE_MATCH_END,     // no payload
+  CAPTURE_RELEASE,       // no payload; time = the cutoff passed to releaseHits()
+};
+
+struct CaptureHeader {
+  uint8_t  version;   // set by decode; encode always writes CAPTURE_VERSION
+  uint16_t planeId;
+  uint32_t startMs;
+};
+
+struct CaptureRecord {
+  int64_t        timeUs;   // since the start of the capture; bytes that
+                           // arrived just before it are negative
+  CaptureKind    kind;
+  uint8_t        cam;
+  const uint8_t* data;
+  size_t         len;
+};
+
+void encodeCaptureHeader(const CaptureHeader& h, uint8_t* out);
+bool decodeCaptureHeader(const uint8_t* data, size_t len, CaptureHeader& h);
+
+// ---------------------------
+// READER
+// ---------------------------
+// Walks the records of an in-memory capture (header excluded).
+class CaptureReader {
+public:
+  CaptureReader(const uint8_t* data, size_t len, uint8_t version = CAPTURE_VERSION)
+      : p(data), end(data + len), version(version) {}
+
+  // Returns false at the end, or on a truncated record (see truncated).
+  bool next(CaptureRecord& r);
+
+  bool truncated = false;
+
+private:
+  const uint8_t* p;
+  const uint8_t* end;
+  uint8_t        version;
+  int64_t        timeUs = 0;
+};
+
+// ---------------------------
+// RING (recording side)
+// ---------------------------
+// Single-producer / single-consumer byte ring. The producer appends
+// whole records or nothing (counted in dropped); the consumer drains raw
+// bytes to flash or the network without caring about record bounds.
+class CaptureRing {
+public:
+  CaptureRing(uint8_t* storage, size_t capacity) : buf(storage), cap(capacity) {}
+
+  // Producer: empties the ring and sets the time origin. Only call while
+  // the consumer is idle.
+  void restart(uint32_t nowUs);
+
+  // Producer. cam < CAPTURE_CAMERAS_MAX.
+  bool append(uint32_t nowUs, CaptureKind kind, uint8_t cam, const uint8_t* data, size_t len);
+
+  // Consumer: copies up to max bytes out, returns the count.
+  size_t read(uint8_t* out, size_t max);
+
+  size_t used() const;
+  size_t capacity() const { return cap; }
+
+  uint32_t dropped = 0;   // records that did not fit
+
+private:
+  void put(const uint8_t* src, size_t n, size_t at);
+
+  uint8_t* buf;
+  size_t   cap;
+  uint32_t lastUs = 0;
+  std::atomic<size_t> head{0};   // total bytes written
+  std::atomic<size_t> tail{0};   // total bytes read
+};
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// PHONE COMMANDS (WebSocket text)
+// ---------------------------
+
+enum PhoneCommand {
+  CMD_UNKNOWN,
+  CMD_MATCH_START,
+  CMD_MATCH_END,
+};
+
+// Parses a raw WebSocket payload (not NUL-terminated), ignoring
+// surrounding whitespace.
+PhoneCommand parseCommand(const char* data, size_t len);
+
+// "SYNC <since>" (match_record.h), unsigned: it only reads. since is
+// decimal; false for anything else.
+bool parseSyncCommand(const char* data, size_t len, uint32_t& since);
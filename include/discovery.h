@@ -0,0 +1,27 @@
+#pragma once
+
+// ---------------------------
+// mDNS DISCOVERY
+// ---------------------------
+// Registers <plane.hostname>.local and advertises an _aeroduel._tcp service on
+// port 80 whose TXT records carry everything the phone needs to connect:
+//
+//   id     fleet plane id
+//   name   plane display name
+//   model  airframe model
+//   status "ready" | "in_match"
+//   fw     firmware version
+//   ws     WebSocket path
+//
+// One DNS-SD browse then finds and describes every plane on the field,
+// with no per-plane GET /id round-trip.
+
+#define MDNS_SERVICE  "_aeroduel"
+#define MDNS_PROTO    "_tcp"
+
+struct PlaneIdentity;
+
+bool discoveryBegin(const PlaneIdentity& plane);
+
+// Updates the status TXT record; mDNS re-announces the change.
+void discoverySetStatus(const char* status);
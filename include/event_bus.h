@@ -0,0 +1,64 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "spsc_queue.h"
+
+// ---------------------------
+// EVENT BUS
+// ---------------------------
+// Subscribers are template arguments, so the wiring is fixed at compile
+// time and publish() is a run of direct calls in list order: no
+// registry, no virtual dispatch, nothing allocated. A bus is a typedef:
+//
+//   typedef EventBus<HitEvent, sendUdp, sendLora, HitLog::deliver> HitBus;
+//   HitBus::publish(hit);
+//
+// Adding a sink means adding it to the list; the publisher is untouched.
+// HitBus::publish also fits a plain function pointer (HitSink).
+//
+// A subscriber that should not run on the publisher's stack goes through
+// AsyncSubscriber: its deliver() only queues the event, and the owner
+// calls drain() when it has time. A full queue drops the event (counted).
+
+template <typename Event, void (*... Subscribers)(const Event&)>
+struct EventBus {
+  static void publish(const Event& e) {
+    int expand[] = { 0, (Subscribers(e), 0)... };
+    (void)expand;
+  }
+
+  static constexpr size_t subscribers() { return sizeof...(Subscribers); }
+};
+
+// Handler runs from drain(), on whichever task calls it. deliver() and
+// drain() may be on different tasks (one each); Event is copied, keep it
+// small.
+template <typename Event, void (*Handler)(const Event&), size_t N>
+struct AsyncSubscriber {
+  static void deliver(const Event& e) {
+    if (!queue.push(e)) dropped++;
+  }
+
+  // Returns the number handled.
+  static uint32_t drain() {
+    uint32_t n = 0;
+    Event e;
+    while (queue.pop(e)) {
+      Handler(e);
+      n++;
+    }
+    return n;
+  }
+
+  static size_t pending() { return queue.size(); }
+
+  static SpscQueue<Event, N> queue;
+  static uint32_t dropped;
+};
+
+template <typename Event, void (*Handler)(const Event&), size_t N>
+SpscQueue<Event, N> AsyncSubscriber<Event, Handler, N>::queue;
+
+template <typename Event, void (*Handler)(const Event&), size_t N>
+uint32_t AsyncSubscriber<Event, Handler, N>::dropped = 0;
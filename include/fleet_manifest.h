@@ -0,0 +1,17 @@
+#pragma once
+
+// GENERATED by fleet/gen_fleet.py from fleet/fleet.json - do not edit.
+
+#include "plane_identity_types.h"
+#include "version.h"
+
+constexpr PlaneIdentity kFleet[] = {
+  {
+    1, "Foxtrot White", "foxtrotwhite", "F22",
+    "{\"name\":\"Foxtrot White\",\"model\":\"F22\",\"id\":1,\"fw\":\"" FIRMWARE_VERSION "\",\"status\":\"ready\"}",
+    "{\"name\":\"Foxtrot White\",\"model\":\"F22\",\"id\":1,\"fw\":\"" FIRMWARE_VERSION "\",\"status\":\"in_match\"}",
+    { 915000000u, 7, 125000u, 5, 0x34, 17 },
+  },
+};
+
+constexpr size_t kFleetSize = 1;
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdint.h>
+#include "json_out.h"
+
+// ---------------------------
+// HEAP TRACKING
+// ---------------------------
+// With HEAP_TRACK=1 the env links with -Wl,--wrap=malloc,free,calloc,realloc
+// and every allocation is counted against the subsystem whose task made
+// it (tasks are classified by FreeRTOS task name). Without it only the
+// heap totals are reported.
+//
+// Allocations done with heap_caps_malloc() directly are not seen.
+
+#ifndef HEAP_TRACK
+#define HEAP_TRACK 0
+#endif
+
+enum HeapSubsystem {
+  HEAP_SYS_LOOP,      // loopTask: camera ingest, hit pipeline, WS / UDP / mDNS sends
+  HEAP_SYS_NETWORK,   // async_tcp: HTTP + WebSocket handlers
+  HEAP_SYS_TIMER,     // esp_timer callbacks (UDP copies)
+  HEAP_SYS_WIFI,      // WiFi / lwIP / event tasks
+  HEAP_SYS_OTHER,
+  HEAP_SYS_COUNT,
+};
+
+struct HeapSubsystemStats {
+  uint32_t allocs;
+  uint32_t frees;
+  uint32_t bytes;        // total bytes allocated (heap block sizes)
+  uint32_t failed;       // allocations that returned NULL
+};
+
+// Marks the end of setup(); /metrics then also reports allocations made
+// since this point. loopTask's count is not expected to be 0: the
+// AsyncWebSocket, lwIP and mDNS calls it makes allocate internally.
+void heapTrackSetupDone();
+
+HeapSubsystemStats heapTrackStats(HeapSubsystem sys);
+
+// Writes a "heap":{...} member: free, min_free, largest_block, frag_pct
+// and, with HEAP_TRACK, per-subsystem counters.
+void heapTrackWriteJson(JsonOut& j);
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// HIT MERGE (several cameras -> one stream)
+// ---------------------------
+// Detections carry the time their bytes arrived, not the time they were
+// parsed, so hits from different cameras can be put back in order. pop()
+// hands them out oldest first, but only up to a cutoff the caller knows
+// no camera can still deliver anything older than.
+//
+// Two cameras watching the same aircraft both see one shot. A detection
+// within dedupUs of the last released hit from a different camera is
+// dropped as the same hit; a camera's own repeats are never merged
+// (the H7 already debounces its own frames).
+
+#define HIT_CAMERAS_MAX 4
+#define HIT_MERGE_MAX 32
+
+#ifndef HIT_DEDUP_US
+#define HIT_DEDUP_US 30000
+#endif
+
+struct CameraDetection {
+  uint64_t timeUs;   // arrival of the byte that completed the line
+  uint8_t  cam;
+};
+
+class HitMerger {
+public:
+  explicit HitMerger(uint32_t dedupUs = HIT_DEDUP_US) : dedupUs(dedupUs) {}
+
+  // false (and counted) when HIT_MERGE_MAX detections are already waiting.
+  bool push(const CameraDetection& d);
+
+  // Oldest waiting detection at or before cutoffUs, duplicates removed.
+  bool pop(uint64_t cutoffUs, CameraDetection& out);
+
+  size_t pending() const { return count; }
+
+  uint32_t duplicates[HIT_CAMERAS_MAX] = {};   // by the camera that was dropped
+  uint32_t late = 0;        // arrived older than a hit already released
+  uint32_t overflows = 0;
+
+private:
+  uint32_t dedupUs;
+  CameraDetection waiting[HIT_MERGE_MAX];   // sorted by timeUs
+  size_t   count = 0;
+  bool     released = false;
+  CameraDetection last = {};
+};
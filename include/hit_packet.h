@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// HIT PACKET (UDP wire format)
+// ---------------------------
+// Fixed 20-byte little-endian datagram sent on the UDP hit channel.
+// Every hit is sent several times (copy 0..copies-1) with the same seq,
+// receivers keep the first copy and drop the rest.
+//
+//   0  'A' 'D'      magic
+//   2  u8           version
+//   3  u8           type (HIT_PACKET_HIT)
+//   4  u16          planeId
+//   6  u16          bootId   (random per boot, resets receiver windows)
+//   8  u32          seq      (per-boot hit counter, starts at 1)
+//  12  u32          timeMs   (plane uptime when the hit was detected)
+//  16  u8           copy
+//  17  u8           copies
+//  18  u16          reserved (0)
+//  20  16 bytes     tag, authenticated planes only (match_auth.h):
+//                   HMAC-SHA256(match key, bytes 0..15), truncated
+//
+// The tag leaves out copy / copies so one MAC covers every copy.
+// Receivers that do not check it read the first 20 bytes as before.
+
+#define HIT_PACKET_VERSION 1
+#define HIT_PACKET_SIZE    20
+#define HIT_PACKET_HIT     1
+
+#define HIT_PACKET_SIGNED    16
+#define HIT_PACKET_TAG       16
+#define HIT_PACKET_AUTH_SIZE (HIT_PACKET_SIZE + HIT_PACKET_TAG)
+
+struct HitPacket {
+  uint8_t  type;
+  uint16_t planeId;
+  uint16_t bootId;
+  uint32_t seq;
+  uint32_t timeMs;
+  uint8_t  copy;
+  uint8_t  copies;
+};
+
+// Writes exactly HIT_PACKET_SIZE bytes into out.
+void encodeHitPacket(const HitPacket& pkt, uint8_t* out);
+
+// Returns false if the buffer is not a valid hit packet.
+bool decodeHitPacket(const uint8_t* data, size_t len, HitPacket& pkt);
+
+// ---------------------------
+// SEQUENCE WINDOW (de-duplication)
+// ---------------------------
+// Tracks the highest sequence seen plus a 64-entry bitmap below it.
+// accept() returns true exactly once per sequence number inside the
+// window; anything older than the window is treated as a duplicate.
+class SeqWindow {
+public:
+  void reset();
+  bool accept(uint32_t seq);
+
+  uint32_t highest() const { return high; }
+
+private:
+  uint32_t high = 0;
+  uint64_t seen = 0;   // bit i set => (high - i) already delivered
+  bool     started = false;
+};
+
+// ---------------------------
+// HIT RECEIVER
+// ---------------------------
+// Per-plane de-duplication for consumers of the UDP hit channel.
+// Fixed table, no allocation; once full, new planes are rejected and
+// counted in droppedPlanes.
+#define HIT_RECEIVER_MAX_PLANES 64
+
+class HitReceiver {
+public:
+  // Returns true if pkt is the first copy of a new hit.
+  bool accept(const HitPacket& pkt);
+
+  uint32_t duplicates    = 0;
+  uint32_t droppedPlanes = 0;
+
+private:
+  struct Slot {
+    bool      used;
+    uint16_t  planeId;
+    uint16_t  bootId;
+    SeqWindow window;
+  };
+
+  Slot slots[HIT_RECEIVER_MAX_PLANES] = {};
+};
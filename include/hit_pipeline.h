@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "camera_link.h"
+#include "hit_merge.h"
+
+// ---------------------------
+// HIT PIPELINE (cameras -> broadcast)
+// ---------------------------
+// Everything between raw camera bytes and "send this hit": line assembly
+// per camera, classification, the match gate, the cross-camera merge
+// (hit_merge.h) and sequence numbering. Transports are attached as a
+// sink. Allocation-free once constructed; the native alloc guard
+// (bench/, --alloc-guard) enforces that.
+//
+// Heartbeats from every camera are counted and go to the heartbeat sink
+// with their camera, so each camera's control channel hears its own.
+
+struct HitEvent {
+  uint32_t seq;      // per-boot, starts at 1
+  uint32_t timeMs;   // plane uptime at detection
+};
+
+// MATCH_START / MATCH_END as accepted from the phone.
+struct MatchEvent {
+  bool active;
+};
+
+typedef void (*HitSink)(const HitEvent& hit);
+typedef void (*HeartbeatSink)(uint8_t cam, const CameraHealth& health, uint32_t nowMs);
+
+struct CameraInputStats {
+  uint32_t bytes         = 0;
+  uint32_t lines         = 0;
+  uint32_t hits          = 0;   // detections, before the merge
+  uint32_t unknown       = 0;
+  uint32_t heartbeats    = 0;
+  uint32_t badHeartbeats = 0;
+};
+
+class HitPipeline {
+public:
+  void setSink(HitSink s) { sink = s; }
+  void setHeartbeatSink(HeartbeatSink s) { heartbeatSink = s; }
+
+  void setMatchActive(bool active) { matchActive = active; }
+  bool isMatchActive() const { return matchActive; }
+
+  // Raw bytes from camera `cam` that arrived at arrivalUs. Hits wait in
+  // the merge until releaseHits(); returns the number detected.
+  uint32_t feedCamera(uint8_t cam, const uint8_t* data, size_t len, uint64_t arrivalUs);
+
+  // Sends merged hits that arrived at or before cutoffUs to the sink, in
+  // arrival order; returns the number sent.
+  uint32_t releaseHits(uint64_t cutoffUs);
+
+  // One camera, nothing to wait for: bytes in, hits out.
+  uint32_t feedCamera(const uint8_t* data, size_t len, uint32_t nowMs);
+
+  uint32_t lastSeq() const { return seq; }
+  const CameraLineReader& reader(uint8_t cam = 0) const { return lines[cam]; }
+  const CameraInputStats& input(uint8_t cam) const { return stats[cam]; }
+  const HitMerger& merger() const { return merge; }
+  uint32_t overflows() const;   // all cameras
+
+  // All cameras
+  uint32_t camLines      = 0;
+  uint32_t unknownLines  = 0;
+  uint32_t hitsIgnored   = 0;   // detected outside a match
+  uint32_t heartbeats    = 0;
+  uint32_t badHeartbeats = 0;   // "HB" lines that failed to parse
+
+private:
+  CameraLineReader lines[HIT_CAMERAS_MAX];
+  CameraInputStats stats[HIT_CAMERAS_MAX];
+  HitMerger        merge;
+  HitSink       sink = nullptr;
+  HeartbeatSink heartbeatSink = nullptr;
+  bool     matchActive = true;   // TEMP: always allow hits so we can test
+  uint32_t seq = 0;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include "mbedtls/sha256.h"
+#endif
+
+// ---------------------------
+// SHA-256 / HMAC-SHA256
+// ---------------------------
+// Sha256 is the portable software implementation (FIPS 180-4). HMAC
+// keys are expanded once into the inner and outer hash states after
+// the pad block, so every MAC afterwards costs two compressions for a
+// short message instead of four.
+//
+// On the ESP32 the default backend is mbedtls, which runs the
+// compressions on the SHA peripheral; the software path stays
+// available so both can be benchmarked on the same board.
+
+#define SHA256_BYTES 32
+#define SHA256_BLOCK 64
+
+class Sha256 {
+public:
+  Sha256() { reset(); }
+
+  void reset();
+  void update(const uint8_t* data, size_t len);
+  void finish(uint8_t out[SHA256_BYTES]);
+
+private:
+  void compress(const uint8_t* block);
+
+  uint32_t h[8];
+  uint64_t total;
+  uint8_t  buf[SHA256_BLOCK];
+  size_t   used;
+};
+
+void sha256(const uint8_t* data, size_t len, uint8_t out[SHA256_BYTES]);
+
+enum HmacBackend : uint8_t {
+  HMAC_SOFTWARE,
+  HMAC_HARDWARE,   // ESP32 SHA peripheral; software on native builds
+};
+
+#ifdef ARDUINO
+#define HMAC_DEFAULT_BACKEND HMAC_HARDWARE
+#else
+#define HMAC_DEFAULT_BACKEND HMAC_SOFTWARE
+#endif
+
+class HmacSha256 {
+public:
+  explicit HmacSha256(HmacBackend b = HMAC_DEFAULT_BACKEND);
+  ~HmacSha256();
+  HmacSha256(const HmacSha256&) = delete;
+  HmacSha256& operator=(const HmacSha256&) = delete;
+
+  void setKey(const uint8_t* key, size_t len);
+  bool hasKey() const { return keyed; }
+
+  // setKey() prepares both backends, so this can change at any time.
+  void setBackend(HmacBackend b) { mode = b; }
+  HmacBackend backend() const { return mode; }
+
+  // Reentrant: the precomputed states are only read.
+  void mac(const uint8_t* msg, size_t len, uint8_t out[SHA256_BYTES]) const;
+  void mac2(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen,
+            uint8_t out[SHA256_BYTES]) const;
+
+private:
+  HmacBackend mode;
+  bool        keyed = false;
+  Sha256      inner, outer;
+#ifdef ARDUINO
+  mbedtls_sha256_context hwInner, hwOuter;
+#endif
+};
+
+// Constant time.
+bool macEqual(const uint8_t* a, const uint8_t* b, size_t len);
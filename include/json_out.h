@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// JSON WRITER (fixed buffer)
+// ---------------------------
+// Appends to a caller-owned buffer and inserts commas itself. Once
+// anything fails to fit, every later call is a no-op and finish()
+// returns 0. Strings are escaped for '"', '\\' and control characters.
+
+class JsonOut {
+public:
+  JsonOut(char* out, size_t cap);
+
+  void beginObject(const char* key = nullptr);
+  void endObject();
+  void beginArray(const char* key = nullptr);
+  void endArray();
+
+  void field(const char* key, const char* value);
+  void field(const char* key, uint32_t value);
+  void field(const char* key, int32_t value);
+  void field(const char* key, bool value);
+
+  // Array elements
+  void value(uint32_t v);
+  void value(const char* s);
+
+  // Length written (excluding the NUL), or 0 on overflow.
+  size_t finish();
+
+private:
+  void raw(const char* s);
+  void ch(char c);
+  void str(const char* s);
+  void key(const char* k);
+  void comma();
+
+  char*  out;
+  size_t cap;
+  size_t len = 0;
+  bool   ok;
+  bool   first = true;   // no comma before the next element
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include "json_out.h"
+#include "plane_identity_types.h"
+
+// ---------------------------
+// LORA HIT RADIO (plane end)
+// ---------------------------
+// Sends every hit over LoRa as a backup to WiFi, at whatever rate the
+// ground asks for (lora_sync.h). The plane only follows: the ground
+// measures the uplink with LoraRateController and requests changes.
+// Radio settings come from the fleet manifest; the manifest SF/BW is the
+// starting rate, the slowest ladder rate is where both ends meet after
+// losing each other.
+//
+// The Heltec LoRa V4 radio is an SX1262, driven with RadioLib. Everything
+// runs from loop(): the radio sits in receive between frames, TX is
+// asynchronous, and the DIO1 interrupt (TX done or RX done) only sets a
+// flag. Hits waiting for the radio are pooled HitEvents (POOL_HIT_EVENTS
+// in pool_config.h).
+
+#ifndef LORA_ENABLED
+#define LORA_ENABLED 1
+#endif
+
+// Heltec LoRa V4 wiring (SX1262)
+#ifndef LORA_PIN_NSS
+#define LORA_PIN_NSS 8
+#endif
+#ifndef LORA_PIN_SCK
+#define LORA_PIN_SCK 9
+#endif
+#ifndef LORA_PIN_MOSI
+#define LORA_PIN_MOSI 10
+#endif
+#ifndef LORA_PIN_MISO
+#define LORA_PIN_MISO 11
+#endif
+#ifndef LORA_PIN_RST
+#define LORA_PIN_RST 12
+#endif
+#ifndef LORA_PIN_BUSY
+#define LORA_PIN_BUSY 13
+#endif
+#ifndef LORA_PIN_DIO1
+#define LORA_PIN_DIO1 14
+#endif
+
+// The SX1262 runs from a TCXO powered through DIO3.
+#ifndef LORA_TCXO_VOLTAGE
+#define LORA_TCXO_VOLTAGE 1.8f
+#endif
+
+#ifndef LORA_PREAMBLE
+#define LORA_PREAMBLE 8
+#endif
+
+// Disabled (and logged) if the radio does not answer.
+void loraRadioBegin(const LoraParams& params, uint16_t planeId);
+
+// loop() only
+void loraRadioSendHit(uint32_t seq, uint32_t timeMs);
+void loraRadioPoll(uint32_t nowMs);
+
+// Fields for /metrics, inside an open object.
+void loraRadioWriteJson(JsonOut& j);
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// LORA RATE LADDER + CONTROLLER
+// ---------------------------
+// Settings are ordered fastest first. Each one needs a minimum SNR to
+// demodulate (SX127x datasheet) plus the noise of its bandwidth, so all
+// SNR figures here are normalised to 125 kHz: a packet heard at 500 kHz
+// with SNR s counts as s + 6 dB.
+//
+// The controller runs on the receiving side of a link. It smooths SNR
+// per packet and loss (from link sequence gaps) with EWMAs, then asks for
+// the fastest setting that keeps SNR margin above marginDb and loss
+// under targetLoss. Slower is allowed after downHoldMs, faster only
+// after upHoldMs with upExtraDb of extra margin, so fading near a
+// threshold does not make the link flap.
+
+#define LORA_RATE_COUNT 8
+#define LORA_RATE_SLOWEST (LORA_RATE_COUNT - 1)
+
+struct LoraRate {
+  uint8_t  sf;
+  uint32_t bwHz;
+  float    floorDb;   // demodulation floor at this SF
+};
+
+extern const LoraRate loraRates[LORA_RATE_COUNT];
+
+// Required SNR (125 kHz normalised) to use rate i, before margin.
+float loraRequiredSnr(int i);
+
+// Measured SNR at rate i -> 125 kHz normalised.
+float loraNormaliseSnr(float snrDb, int i);
+
+// Time on air (Semtech AN1200.13), explicit header, CRC on.
+uint32_t loraAirtimeUs(const LoraRate& r, uint8_t codingRate4, size_t payloadLen,
+                       uint8_t preamble = 8);
+
+struct LoraRateConfig {
+  float    targetLoss = 0.05f;
+  float    marginDb   = 3.0f;
+  float    upExtraDb  = 1.5f;
+  float    ewmaAlpha  = 0.2f;     // SNR / RSSI
+  float    lossAlpha  = 1.0f / 32;
+  uint16_t minSamples = 8;        // packets at a rate before deciding
+  uint32_t upHoldMs   = 8000;
+  uint32_t downHoldMs = 1000;
+};
+
+class LoraRateController {
+public:
+  explicit LoraRateController(const LoraRateConfig& c = LoraRateConfig()) : cfg(c) {}
+
+  // Every frame decoded from the peer, with its link sequence number.
+  void onReceived(uint16_t linkSeq, float snrDb, float rssiDbm, int rate, uint32_t nowMs);
+
+  // Rate the link should move to; == current when it should stay.
+  int decide(int current, uint32_t nowMs) const;
+
+  // Both sides switched: loss restarts, SNR is carried over.
+  void onRateChanged(uint32_t nowMs);
+
+  float snr() const { return snrEwma; }     // 125 kHz normalised
+  float rssi() const { return rssiEwma; }
+  float loss() const { return lossEwma; }
+  uint32_t samples() const { return count; }
+
+private:
+  LoraRateConfig cfg;
+  float    snrEwma = 0;
+  float    rssiEwma = 0;
+  float    lossEwma = 0;
+  uint32_t count = 0;        // since the last rate change
+  uint32_t total = 0;
+  uint16_t lastSeq = 0;
+  uint32_t changedMs = 0;
+};
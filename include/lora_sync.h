@@ -0,0 +1,166 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hit_packet.h"
+#include "lora_rate.h"
+
+// ---------------------------
+// LORA FRAMES
+// ---------------------------
+// Little-endian, 9-byte header + 8 bytes for hits, + 16 when signed:
+//
+//   0xAD, type, planeId u16, linkSeq u16, epoch, rate, peerSnr (0.25 dB)
+//   HIT: seq u32, timeMs u32 [, tag]
+//
+// linkSeq counts every frame a side sends, so the receiver sees loss as
+// gaps. peerSnr is the sender's smoothed SNR of the other direction.
+//
+// On authenticated planes a HIT carries the same tag as the UDP packet
+// (hit_packet.h): HMAC-SHA256(match key, bytes 0..16), truncated. Link
+// control frames are not signed; a forged one can only move the rate.
+
+#define LORA_FRAME_MAGIC 0xAD
+#define LORA_FRAME_HEADER 9
+#define LORA_FRAME_HIT_SIGNED 17
+#define LORA_FRAME_MAX (LORA_FRAME_HIT_SIGNED + HIT_PACKET_TAG)
+
+enum LoraFrameType : uint8_t {
+  LORA_FRAME_HIT = 1,
+  LORA_FRAME_BEACON,
+  LORA_FRAME_RATE_REQ,   // ground -> plane: switch to rate, new epoch
+  LORA_FRAME_RATE_ACK,   // plane -> ground, sent at the old rate
+};
+
+struct LoraFrame {
+  LoraFrameType type;
+  uint16_t planeId;
+  uint16_t linkSeq;
+  uint8_t  epoch;
+  uint8_t  rate;
+  int8_t   peerSnrQ4;
+  uint32_t hitSeq;
+  uint32_t hitTimeMs;
+  bool     tagged;
+  uint8_t  tag[HIT_PACKET_TAG];
+};
+
+// Writes the frame and returns its length. A tagged HIT gets f.tag as
+// given; compute it over the first LORA_FRAME_HIT_SIGNED bytes after
+// stamping and write it in with loraFrameSetTag().
+size_t encodeLoraFrame(const LoraFrame& f, uint8_t* out);
+bool decodeLoraFrame(const uint8_t* data, size_t len, LoraFrame& f);
+
+// Appends tag to an encoded, untagged HIT; returns the new length.
+size_t loraFrameSetTag(uint8_t* frame, const uint8_t tag[HIT_PACKET_TAG]);
+
+// ---------------------------
+// RATE SYNC (both ends of one link)
+// ---------------------------
+// Plane and ground must change rate together or they stop hearing each
+// other. Only the ground decides:
+//
+//   ground  RATE_REQ(e+1, r') at r, retried
+//   plane   RATE_ACK(e+1, r') at r, then moves to r' and verifies
+//   ground  on ACK moves to r' and verifies
+//
+// Verifying means going back to r unless anything from the peer is
+// heard at r' within verifyMs. The plane probes with a beacon at once
+// and every verifyMs/3; the ground stays quiet and answers the first
+// frame it hears, so the two probes never collide. A lost REQ is
+// retried; a lost ACK makes the plane revert and ACK the next retry. If
+// nothing at all is heard for lostMs, both ends drop to baseRate, which
+// they always agree on. That only happens once the peer has been heard:
+// until then both ends stay on the rate they started at (the manifest
+// rate), so a plane with no ground station in range keeps its manifest
+// SF/BW instead of crawling at the slowest rate. Timers stretch with airtime so a slow rate is
+// not declared dead, or beaconed at a high duty cycle.
+//
+// Radios are half duplex, so a busy plane would never hear a REQ. After
+// each of its frames the plane holds hits for one control frame plus
+// listenSlackMs, and the ground only transmits in that window (like a
+// LoRaWAN class A downlink) unless the plane has gone quiet.
+
+enum LoraRole : uint8_t { LORA_ROLE_PLANE, LORA_ROLE_GROUND };
+
+enum LoraSyncState : uint8_t {
+  LORA_SYNC_STABLE,
+  LORA_SYNC_REQUESTING,   // ground, waiting for ACK
+  LORA_SYNC_ACKING,       // plane, ACK queued at the old rate
+  LORA_SYNC_VERIFY,
+};
+
+struct LoraSyncConfig {
+  uint8_t  codingRate4 = 5;
+  int      baseRate    = LORA_RATE_SLOWEST;
+  uint32_t beaconMs    = 2000;   // at least; also >= 20x airtime (5% duty)
+  uint32_t retryMs     = 300;    // at least; also >= 3x airtime
+  uint8_t  maxRetries  = 4;
+  uint32_t verifyMs    = 1500;   // at least; also >= 4x airtime
+  uint32_t lostMs      = 10000;  // at least; also >= 4 beacons
+  uint32_t listenSlackMs = 40;   // two loop periods of turnaround
+};
+
+class LoraRateSync {
+public:
+  LoraRateSync(LoraRole role, uint16_t planeId, int initialRate,
+               const LoraSyncConfig& c = LoraSyncConfig());
+
+  int rate() const { return cur; }
+  LoraSyncState state() const { return st; }
+  uint8_t epoch() const { return ep; }
+
+  // Ground: start moving to newRate (ignored unless STABLE).
+  void request(int newRate, uint32_t nowMs);
+
+  // Every frame decoded from the peer.
+  void onFrame(const LoraFrame& f, uint32_t nowMs);
+
+  // Link control frame due now (REQ, ACK, beacon)? Send it at rate().
+  bool poll(uint32_t nowMs, LoraFrame& out);
+
+  // When any transmission, control or hit, has finished (TX done).
+  void onSent(uint32_t nowMs);
+
+  // Plane: false while the peer may be answering the last frame.
+  bool hitClear(uint32_t nowMs) const;
+
+  // Fills the common header of an outgoing frame (hits included).
+  void stamp(LoraFrame& f);
+
+  void setPeerSnr(float snrDb) { peerSnr = snrDb; }
+
+  uint32_t changes   = 0;   // rate() changed for any reason
+  uint32_t switches  = 0;   // verified moves
+  uint32_t reverts   = 0;   // verify timed out
+  uint32_t abandoned = 0;   // REQ never acknowledged
+  uint32_t fallbacks = 0;   // link lost, back to baseRate
+
+private:
+  uint32_t airtimeMs(int rate) const;
+  uint32_t listenMs() const;
+  uint32_t beaconEvery() const;
+  void setRate(int r, uint32_t nowMs);
+
+  LoraRole       role;
+  uint16_t       planeId;
+  LoraSyncConfig cfg;
+  LoraSyncState  st = LORA_SYNC_STABLE;
+
+  int      cur;
+  int      prev = 0;
+  int      pendingRate = 0;
+  uint8_t  ep = 0;
+  uint8_t  prevEp = 0;
+  uint8_t  retries = 0;
+  uint16_t txSeq = 0;
+  float    peerSnr = 0;
+
+  bool     started = false;
+  bool     beaconNow = false;
+  bool     ackOut = false;     // poll() handed out the ACK
+  bool     peerHeard = false;  // any frame from the peer, ever
+  uint32_t heardMs = 0;
+  uint32_t sentMs = 0;        // last frame of any kind
+  uint32_t stateMs = 0;       // entered current state / last REQ
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "commands.h"
+#include "hit_packet.h"
+#include "hmac_sha256.h"
+
+// ---------------------------
+// MATCH AUTHENTICATION
+// ---------------------------
+// Keys (all HMAC-SHA256):
+//   plane key  = HMAC(fleet secret, "plane <id>")
+//   match key  = HMAC(plane key, "match <nonce> <challenge>")
+//
+// The phone knows the fleet secret. It reads a fresh challenge from the
+// plane (GET /auth/challenge), picks a nonce, and starts the match with
+//   MATCH_START <nonce> <tag>      tag over "MATCH_START <nonce> <challenge>", plane key
+// The challenge changes after every accepted start, so an old start
+// cannot be replayed. Every other command carries a sequence number the
+// phone counts from 1 per match, checked with a SeqWindow:
+//   MATCH_END <seq> <tag>          tag over "MATCH_END <seq>", match key
+// Hits from the plane:
+//   HIT <seq> <timeMs> <tag>       tag over "HIT <seq> <timeMs>", match key
+// and binary hits (UDP packet, LoRa HIT frame) carry HIT_PACKET_TAG bytes
+// of the MAC over their fixed fields, same key.
+// Nonce and challenge are 16 hex digits. Tags are the first 16 bytes of
+// the MAC as 32 lowercase hex digits.
+//
+// Commands are checked and hits are signed on loop() (commands reach it
+// through the command pool), so the match key has a single owner and is
+// replaced in place. Only hasMatchKey() is read from other tasks.
+
+#define AUTH_TAG_BYTES 16
+#define AUTH_TAG_HEX   (2 * AUTH_TAG_BYTES)
+#define AUTH_LINE_MAX  96
+
+enum AuthResult : uint8_t {
+  AUTH_OK,
+  AUTH_UNSIGNED,     // no tag at all
+  AUTH_BAD_FORMAT,
+  AUTH_BAD_TAG,
+  AUTH_REPLAY,       // sequence already used, or older than the window
+  AUTH_NO_MATCH,     // signed command before any MATCH_START
+};
+
+// body + ' ' + tag; 0 if it does not fit in cap (NUL included).
+size_t authSignLine(const HmacSha256& key, const char* body, size_t len, char* out, size_t cap);
+
+// Receiver side of tagPacket / tagFrame.
+bool authCheckTag(const HmacSha256& key, const uint8_t* data, size_t len,
+                  const uint8_t tag[HIT_PACKET_TAG]);
+
+// Checks the trailing tag; bodyLen excludes it and its space.
+AuthResult authCheckLine(const HmacSha256& key, const char* line, size_t len, size_t& bodyLen);
+
+// Phone side: "MATCH_START <nonce> <tag>" for the plane's challenge; 0 if
+// it does not fit in cap (NUL included).
+size_t authSignMatchStart(const HmacSha256& planeKey, uint64_t nonce, uint64_t challenge,
+                          char* out, size_t cap);
+
+void authPlaneKey(HmacSha256& out, const char* fleetSecret, uint16_t planeId);
+void authMatchKey(HmacSha256& out, const HmacSha256& planeKey, uint64_t nonce, uint64_t challenge);
+
+class MatchAuth {
+public:
+  explicit MatchAuth(HmacBackend b = HMAC_DEFAULT_BACKEND);
+
+  void begin(const char* fleetSecret, uint16_t planeId, uint64_t challenge);
+  // loop(); other tasks read it through their own published copy.
+  uint64_t challenge() const { return chal; }
+
+  // loop(). On an accepted MATCH_START the match key is replaced and
+  // nextChallenge becomes the challenge.
+  AuthResult verifyCommand(const char* data, size_t len, PhoneCommand& cmd,
+                           uint64_t nextChallenge);
+
+  // Any task.
+  bool hasMatchKey() const { return keyed.load(std::memory_order_relaxed); }
+
+  // loop(). Signed hit line, or 0 without a match key / room.
+  size_t signHit(uint32_t seq, uint32_t timeMs, char* out, size_t cap) const;
+
+  // loop(). Tag for an encoded HitPacket; false without a match key.
+  bool tagPacket(const uint8_t* pkt, uint8_t tag[HIT_PACKET_TAG]) const;
+
+  // loop(). Tag over len bytes of any binary hit frame (LoRa HIT:
+  // LORA_FRAME_HIT_SIGNED); false without a match key.
+  bool tagFrame(const uint8_t* data, size_t len, uint8_t tag[HIT_PACKET_TAG]) const;
+
+  uint32_t accepted  = 0;
+  uint32_t rejected[AUTH_NO_MATCH + 1] = {};   // by AuthResult
+
+private:
+  const HmacSha256* matchKey() const { return hasMatchKey() ? &match : nullptr; }
+
+  HmacSha256 planeKey;
+  HmacSha256 match;
+  std::atomic<bool> keyed{false};
+  uint64_t   chal = 0;
+  SeqWindow  window;
+};
+
+// 16 hex digits, lowercase, no NUL.
+void authHex64(uint64_t v, char out[16]);
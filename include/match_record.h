@@ -0,0 +1,117 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "json_out.h"
+
+// ---------------------------
+// MATCH RECORD (what happened, by version)
+// ---------------------------
+// Everything the plane saw this boot as a timeline of entries: match
+// starts, hits taken, match ends. Every entry gets the next version
+// (1, 2, 3, ...), so a phone that has seen version N asks for "since N"
+// and gets only what it missed; catch-up costs what was missed, not the
+// whole match. The newest MATCH_RECORD_MAX entries are kept. A phone
+// that fell further behind gets reset = true: entries are missing, but
+// the summary counters are absolute and still right.
+//
+// A delta holds at most MATCH_DELTA_MAX entries; when to < head the
+// phone asks again with since = to.
+//
+// Binary delta (integers are LEB128 varints, see varint.h):
+//
+//   'M', MATCH_DELTA_VERSION, flags, boot (u16 LE),
+//   from, to - from, head - to,
+//   match, hits, startMs, lastHitMs,
+//   per entry: type, timeMs - previous (zigzag; first is from 0),
+//              value (HIT: seq - previous HIT seq, else absolute)
+//
+// Entry versions are from + 1 .. to, so they are not sent.
+
+#ifndef MATCH_RECORD_MAX
+#define MATCH_RECORD_MAX 256
+#endif
+
+#ifndef MATCH_DELTA_MAX
+#define MATCH_DELTA_MAX 32
+#endif
+
+#define MATCH_DELTA_VERSION 1
+#define MATCH_DELTA_HEADER_MAX (5 + 7 * 5)
+#define MATCH_DELTA_BYTES_MAX (MATCH_DELTA_HEADER_MAX + MATCH_DELTA_MAX * 11)
+
+#define MATCH_FLAG_RESET  0x01
+#define MATCH_FLAG_ACTIVE 0x02
+
+enum MatchEntryType : uint8_t {
+  MATCH_ENTRY_START = 1,   // value = match number (1 = first this boot)
+  MATCH_ENTRY_HIT   = 2,   // value = hit seq
+  MATCH_ENTRY_END   = 3,   // value = hits taken in that match
+};
+
+struct MatchEntry {
+  uint32_t version;
+  uint32_t timeMs;
+  uint32_t value;
+  uint8_t  type;
+};
+
+// Counters for the current (or last) match.
+struct MatchSummary {
+  uint32_t match;       // 0 before the first MATCH_START
+  bool     active;
+  uint32_t startMs;
+  uint32_t hits;
+  uint32_t lastHitMs;
+};
+
+struct MatchDelta {
+  uint16_t     boot;
+  uint32_t     from;    // the phone's since, raised to what is kept
+  uint32_t     to;      // version of the last entry here
+  uint32_t     head;    // newest version on the plane
+  bool         reset;   // entries after the phone's since were lost
+  MatchSummary summary;
+  uint8_t      count;
+  MatchEntry   entries[MATCH_DELTA_MAX];
+};
+
+class MatchRecord {
+public:
+  explicit MatchRecord(uint16_t boot = 0) : boot(boot) {}
+
+  void setBoot(uint16_t b) { boot = b; }
+
+  void start(uint32_t nowMs);
+  void end(uint32_t nowMs);
+  void hit(uint32_t seq, uint32_t timeMs);
+
+  // Copies everything after version `since`, up to MATCH_DELTA_MAX
+  // entries. since > head (the plane rebooted) is a reset from 0.
+  void delta(uint32_t since, MatchDelta& out) const;
+
+  uint32_t head() const { return version; }
+  size_t   size() const { return count; }
+  const MatchSummary& summary() const { return sum; }
+
+private:
+  void append(uint8_t type, uint32_t timeMs, uint32_t value);
+
+  uint16_t     boot;
+  MatchEntry   ring[MATCH_RECORD_MAX];
+  size_t       count = 0;
+  uint32_t     version = 0;
+  MatchSummary sum = {};
+};
+
+// Returns the length written, or 0 if cap is too small
+// (MATCH_DELTA_BYTES_MAX always fits).
+size_t encodeMatchDelta(const MatchDelta& d, uint8_t* out, size_t cap);
+
+// false on malformed input or more than MATCH_DELTA_MAX entries.
+bool decodeMatchDelta(const uint8_t* data, size_t len, MatchDelta& out);
+
+// The same delta as JSON members inside an open object:
+//   "boot","from","to","head","reset","match","active","start_ms","hits",
+//   "last_hit_ms","entries":[[version,timeMs,"start|hit|end",value],...]
+void writeMatchDeltaJson(JsonOut& j, const MatchDelta& d);
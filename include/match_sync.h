@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hit_pipeline.h"
+#include "json_out.h"
+
+class AsyncWebServer;
+
+// ---------------------------
+// MATCH SYNC
+// ---------------------------
+// Serves the MatchRecord (match_record.h) so a phone that joins or
+// reconnects mid-match can catch up on what it missed:
+//
+//   GET /match?since=N   JSON delta
+//   /ws "SYNC N"         binary delta, to the asking client only
+//
+// The record is fed from the hit and match buses in loop(). HTTP
+// requests copy their delta under a spinlock and encode outside it.
+
+void matchSyncBegin(AsyncWebServer& server);
+
+// Bus subscribers, loop()
+void matchSyncOnHit(const HitEvent& hit);
+void matchSyncOnMatch(const MatchEvent& e);
+
+// Binary delta after version `since`; returns the length, or 0 if cap
+// is below MATCH_DELTA_BYTES_MAX.
+size_t matchSyncEncode(uint32_t since, uint8_t* out, size_t cap);
+
+// Writes a "match":{...} member for /metrics.
+void matchSyncWriteJson(JsonOut& j);
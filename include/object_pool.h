@@ -0,0 +1,84 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// ---------------------------
+// OBJECT POOL
+// ---------------------------
+// Fixed-capacity pool of N objects of type T, all allocated up front.
+// acquire() returns a free slot or nullptr when the pool is dry (counted
+// in exhausted(), the caller degrades), release() gives it back.
+//
+// Lock-free and safe from any number of tasks: the free list is a
+// Treiber stack whose head packs a 16-bit index with a 16-bit tag, so
+// an acquire/release pair racing in between cannot be mistaken for an
+// untouched head (ABA). Slots are not constructed or cleared on
+// acquire; T is expected to be plain data.
+
+template <typename T, size_t N>
+class ObjectPool {
+  static_assert(N >= 1 && N < 0xFFFF, "N must fit a 16-bit index");
+
+public:
+  ObjectPool() {
+    for (size_t i = 0; i < N; i++) next[i].store((uint16_t)(i + 1), std::memory_order_relaxed);
+    next[N - 1].store(NIL, std::memory_order_relaxed);
+    head.store(0, std::memory_order_release);
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  T* acquire() {
+    uint32_t h = head.load(std::memory_order_acquire);
+    for (;;) {
+      uint16_t i = (uint16_t)h;
+      if (i == NIL) {
+        dry.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      uint32_t n = ((h & 0xFFFF0000u) + 0x10000u) | next[i].load(std::memory_order_relaxed);
+      if (head.compare_exchange_weak(h, n, std::memory_order_acquire,
+                                     std::memory_order_acquire)) {
+        noteAcquired();
+        return &slots[i];
+      }
+    }
+  }
+
+  // p must come from this pool's acquire().
+  void release(T* p) {
+    uint16_t i = (uint16_t)(p - slots);
+    uint32_t h = head.load(std::memory_order_relaxed);
+    for (;;) {
+      next[i].store((uint16_t)h, std::memory_order_relaxed);
+      uint32_t n = ((h & 0xFFFF0000u) + 0x10000u) | i;
+      if (head.compare_exchange_weak(h, n, std::memory_order_release,
+                                     std::memory_order_relaxed)) break;
+    }
+    used.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  static constexpr size_t capacity() { return N; }
+  uint32_t inUse() const     { return used.load(std::memory_order_relaxed); }
+  uint32_t highWater() const { return peak.load(std::memory_order_relaxed); }
+  uint32_t exhausted() const { return dry.load(std::memory_order_relaxed); }
+
+private:
+  static const uint16_t NIL = 0xFFFF;
+
+  void noteAcquired() {
+    uint32_t u = used.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t p = peak.load(std::memory_order_relaxed);
+    while (u > p && !peak.compare_exchange_weak(p, u, std::memory_order_relaxed)) {}
+  }
+
+  T slots[N];
+  std::atomic<uint16_t> next[N];
+  std::atomic<uint32_t> head{0};
+  std::atomic<uint32_t> used{0};
+  std::atomic<uint32_t> peak{0};
+  std::atomic<uint32_t> dry{0};
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "commands.h"
+#include "hit_packet.h"
+#include "json_out.h"
+
+class AsyncWebServer;
+
+// ---------------------------
+// PHONE AUTH
+// ---------------------------
+// Firmware side of MatchAuth (match_auth.h): phone commands must be
+// signed, and hits are signed with the key of the match they belong to.
+// The fleet secret is authSecret in src/hiddengems.cpp. MACs use the
+// ESP32 SHA peripheral through mbedtls.
+//
+//   GET /auth/challenge   {"plane":1,"challenge":"<16 hex>"}
+//
+// AUTH_ENABLED=0 restores the plain protocol (unsigned MATCH_START /
+// MATCH_END accepted, plain "HIT" frames, untagged UDP packets and LoRa
+// hits).
+
+#ifndef AUTH_ENABLED
+#define AUTH_ENABLED 1
+#endif
+
+// "HIT <seq> <timeMs> <tag>" + NUL
+#define AUTH_HIT_FRAME_MAX 64
+
+void phoneAuthBegin(AsyncWebServer& server, uint16_t planeId);
+
+// loop(). CMD_UNKNOWN for anything unsigned, forged or replayed.
+PhoneCommand phoneAuthCommand(const char* data, size_t len);
+
+// loop(). WebSocket frame for a hit: signed, or plain "HIT" before the
+// first match key. Returns the length written.
+size_t phoneAuthHitFrame(uint32_t seq, uint32_t timeMs, char* out, size_t cap);
+
+// loop(). Tag for an encoded HitPacket; false while there is no key.
+bool phoneAuthPacketTag(const uint8_t* pkt, uint8_t tag[HIT_PACKET_TAG]);
+
+// loop(). Same for the first len bytes of a LoRa HIT frame.
+bool phoneAuthFrameTag(const uint8_t* data, size_t len, uint8_t tag[HIT_PACKET_TAG]);
+
+// Fields for /metrics, inside an open object.
+void phoneAuthWriteJson(JsonOut& j);
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "fleet_manifest.h"
+
+// ---------------------------
+// THIS PLANE
+// ---------------------------
+// Each plane env in fleet/planes.ini sets -D PLANE_ID=<id>; plain
+// heltec_lora_v4 builds the first plane in the manifest. Everything
+// below resolves at compile time.
+
+#ifndef PLANE_ID
+#define PLANE_ID (kFleet[0].id)
+#endif
+
+constexpr size_t fleetIndex(uint16_t id, size_t i = 0) {
+  return i == kFleetSize ? kFleetSize
+       : kFleet[i].id == id ? i
+       : fleetIndex(id, i + 1);
+}
+
+static_assert(fleetIndex(PLANE_ID) < kFleetSize, "PLANE_ID is not in fleet/fleet.json");
+
+constexpr const PlaneIdentity& kPlane = kFleet[fleetIndex(PLANE_ID)];
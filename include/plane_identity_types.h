@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// PLANE IDENTITY
+// ---------------------------
+// One entry per plane in fleet/fleet.json; the table itself lives in the
+// generated fleet_manifest.h.
+
+struct LoraParams {
+  uint32_t freqHz;
+  uint8_t  spreadingFactor;
+  uint32_t bandwidthHz;
+  uint8_t  codingRate4;    // 4/x
+  uint8_t  syncWord;
+  int8_t   txPowerDbm;
+};
+
+struct PlaneIdentity {
+  uint16_t    id;
+  const char* name;
+  const char* hostname;      // mDNS: <hostname>.local
+  const char* model;
+  const char* idJsonReady;   // complete GET /id bodies, one per status
+  const char* idJsonInMatch;
+  LoraParams  lora;
+};
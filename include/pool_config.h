@@ -0,0 +1,38 @@
+#pragma once
+
+// ---------------------------
+// POOL SIZES
+// ---------------------------
+// Capacity of every fixed pool (pools.h), set at compile time. Counts
+// are also the depth of the queue that carries the pooled objects, so
+// they must be powers of two. Override with -D in platformio.ini.
+
+// Hits waiting for the LoRa radio (one frame can take a second at SF12).
+#ifndef POOL_HIT_EVENTS
+#define POOL_HIT_EVENTS 8
+#endif
+
+// Signed hit frames waiting for room in the WebSocket client queues.
+#ifndef POOL_WS_PAYLOADS
+#define POOL_WS_PAYLOADS 8
+#endif
+
+// "HIT <seq> <timeMs> <tag>" + NUL
+#ifndef POOL_WS_PAYLOAD_BYTES
+#define POOL_WS_PAYLOAD_BYTES 64
+#endif
+
+// UDP hits whose redundant copies are still going out.
+#ifndef POOL_RADIO_PACKETS
+#define POOL_RADIO_PACKETS 4
+#endif
+
+// Phone commands between the AsyncTCP task and loop().
+#ifndef POOL_COMMANDS
+#define POOL_COMMANDS 4
+#endif
+
+// Longest signed command (AUTH_LINE_MAX)
+#ifndef POOL_COMMAND_BYTES
+#define POOL_COMMAND_BYTES 96
+#endif
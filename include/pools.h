@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "hit_packet.h"
+#include "hit_pipeline.h"
+#include "json_out.h"
+#include "object_pool.h"
+#include "pool_config.h"
+
+// ---------------------------
+// FIXED POOLS
+// ---------------------------
+// Everything that used to be made per hit or per command lives in one of
+// these pools, sized in pool_config.h, so nothing on the hit or command
+// path touches the heap after setup(). Every user has a fallback for a
+// dry pool, counted in the pool's "exhausted":
+//
+//   hit_events    LoRa queue full        hit goes out on WiFi only
+//   ws_payloads   WS backed up           hit goes out on UDP / LoRa only
+//   radio_packets UDP copies in flight   copy 0 only, no redundant copies
+//   commands      loop() behind          command dropped, phone resends
+//
+// Library internals (AsyncWebSocket messages, lwIP pbufs) still
+// allocate; the WS outbox keeps those bounded by only sending while the
+// client queues have room.
+
+struct WsPayload {
+  uint16_t len;
+  char     data[POOL_WS_PAYLOAD_BYTES];
+};
+
+// A UDP hit plus its tag; the tag does not cover the copy fields, so it
+// is computed once per hit.
+struct RadioPacket {
+  HitPacket pkt;
+  uint8_t   tag[HIT_PACKET_TAG];
+  bool      tagged;
+};
+
+struct CommandBuffer {
+  uint32_t client;   // AsyncWebSocketClient::id(), for replies
+  uint16_t len;
+  char     data[POOL_COMMAND_BYTES];
+};
+
+extern ObjectPool<HitEvent, POOL_HIT_EVENTS>       hitEventPool;
+extern ObjectPool<WsPayload, POOL_WS_PAYLOADS>     wsPayloadPool;
+extern ObjectPool<RadioPacket, POOL_RADIO_PACKETS> radioPacketPool;
+extern ObjectPool<CommandBuffer, POOL_COMMANDS>    commandPool;
+
+// Copies a raw command into a pooled buffer; nullptr if the pool is dry
+// or the command is longer than any valid one.
+CommandBuffer* poolCommand(const char* data, size_t len);
+
+// Writes a "pools":{...} member with size / in_use / high_water /
+// exhausted per pool.
+void poolsWriteJson(JsonOut& j);
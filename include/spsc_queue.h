@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <atomic>
+
+// ---------------------------
+// SPSC QUEUE
+// ---------------------------
+// Bounded single-producer / single-consumer ring. Lock-free and
+// allocation-free; safe between one producer task and one consumer task
+// (or an ISR and a task). N must be a power of two; capacity is N.
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+  bool push(const T& item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) == N) return false;
+    slots[h & (N - 1)] = item;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T& item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) return false;
+    item = slots[t & (N - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const {
+    return head.load(std::memory_order_acquire) -
+           tail.load(std::memory_order_acquire);
+  }
+
+  static constexpr size_t capacity() { return N; }
+
+private:
+  T slots[N];
+  std::atomic<size_t> head{0};
+  std::atomic<size_t> tail{0};
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include "json_out.h"
+
+// ---------------------------
+// STALL PROFILER
+// ---------------------------
+// Per-task loop profiling. A task brackets each iteration with begin()
+// / end() and marks what it is doing with stage(). The profiler keeps
+// log2 histograms of loop period and run time, and logs every iteration
+// that runs longer than runThresholdUs together with the task and the
+// stage that took longest, and every gap between end() and the next
+// begin() longer than the task's gapThresholdUs. Gaps only mean
+// something for a task that should come round regularly (loop()); an
+// event-driven task such as async_tcp registers with 0, which disables
+// gap checks for it. Times are caller-supplied microseconds.
+//
+// Each task slot is written only by its own task; the stall log is
+// shared and guarded by a spinlock. reset() may run on any task, so it
+// only bumps a generation counter and each task clears its own slot at
+// its next begin().
+
+#define PROFILER_MAX_TASKS   4
+#define PROFILER_MAX_STAGES  8
+#define PROFILER_HIST_BUCKETS 20    // [0,1) [1,2) [2,4) ... [2^18, inf) us
+#define PROFILER_LOG_SIZE    16
+
+enum StallKind : uint8_t {
+  STALL_RUN,   // one iteration ran too long
+  STALL_GAP,   // too long between two iterations (blocked outside begin/end)
+};
+
+struct StallRecord {
+  uint32_t  timeMs;
+  uint32_t  durationUs;
+  uint8_t   task;
+  uint8_t   stage;
+  StallKind kind;
+};
+
+struct TaskProfile {
+  const char*        name;
+  const char* const* stageNames;
+  uint8_t            stageCount;
+  uint32_t           gapThresholdUs;   // 0 = no gap checks
+
+  uint32_t iterations;
+  uint32_t stalls;
+  uint32_t maxPeriodUs;
+  uint32_t maxRunUs;
+  uint32_t periodHist[PROFILER_HIST_BUCKETS];
+  uint32_t runHist[PROFILER_HIST_BUCKETS];
+
+  // Current iteration
+  uint32_t startUs;
+  uint32_t lastStartUs;
+  uint32_t lastEndUs;
+  uint32_t stageStartUs;
+  uint8_t  stage;
+  uint32_t stageUs[PROFILER_MAX_STAGES];
+  uint32_t resetSeen;    // last reset generation this task cleared for
+};
+
+class StallProfiler {
+public:
+  explicit StallProfiler(uint32_t runThresholdUs);
+
+  // Returns the task index, or -1 if the table is full.
+  int addTask(const char* name, const char* const* stageNames, uint8_t stageCount,
+              uint32_t gapThresholdUs);
+
+  void begin(int task, uint32_t nowUs);
+  void stage(int task, uint8_t stage, uint32_t nowUs);
+  void end(int task, uint32_t nowUs, uint32_t nowMs);
+
+  // Clears the stall log now and every task's histograms at its next
+  // begin() (e.g. at match start).
+  void reset();
+
+  // Current stage of a task; safe to read from an ISR.
+  uint8_t currentStage(int task) const { return tasks[task].stage; }
+  const char* stageName(int task, uint8_t stage) const;
+  const char* taskName(int task) const { return tasks[task].name; }
+
+  // Writes "tasks":[...] and "stalls":[...] members.
+  void writeJson(JsonOut& j) const;
+
+  const uint32_t runThresholdUs;
+
+private:
+  void logStall(const StallRecord& r);
+
+  TaskProfile tasks[PROFILER_MAX_TASKS] = {};
+  int         taskCount = 0;
+  std::atomic<uint32_t> resetGen{0};
+
+  StallRecord log[PROFILER_LOG_SIZE] = {};
+  uint32_t    logNext = 0;     // total stalls ever logged
+  mutable std::atomic_flag logLock = ATOMIC_FLAG_INIT;
+};
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stdint.h>
+
+class AsyncWebServer;
+
+// ---------------------------
+// STALL WATCH
+// ---------------------------
+// Firmware side of StallProfiler: profiles loop() and the async_tcp
+// request handlers, feeds the ESP32 task watchdog from loop(), and
+// serves GET /stalls. Reports are reset on MATCH_START so /stalls after
+// a match covers exactly that match.
+//
+// When the task watchdog fires, the current loop / network stages are
+// saved in RTC memory. With STALL_WDT_RECOVER=1 the watchdog also resets
+// the plane, and the saved record shows up under "previous_boot".
+
+#ifndef STALL_RUN_THRESHOLD_US
+#define STALL_RUN_THRESHOLD_US 5000      // one loop() pass
+#endif
+
+#ifndef STALL_GAP_THRESHOLD_US
+#define STALL_GAP_THRESHOLD_US 100000    // between loop() passes (loop sleeps 20 ms)
+#endif
+
+#ifndef STALL_WDT_TIMEOUT_S
+#define STALL_WDT_TIMEOUT_S 3
+#endif
+
+#ifndef STALL_WDT_RECOVER
+#define STALL_WDT_RECOVER 0
+#endif
+
+enum LoopStage : uint8_t {
+  LOOP_STAGE_OTHER,
+  LOOP_STAGE_CAMERA,      // draining camera queues + hit pipeline
+  LOOP_STAGE_BROADCAST,   // UDP + WebSocket send
+  LOOP_STAGE_LOG,         // Serial prints
+  LOOP_STAGE_TELEMETRY,
+};
+
+enum NetStage : uint8_t {
+  NET_STAGE_OTHER,
+  NET_STAGE_HTTP,
+  NET_STAGE_WS,
+};
+
+// Call at the end of setup(), with how long the WiFi wait took.
+void stallWatchBegin(AsyncWebServer& server, uint32_t wifiWaitMs);
+
+void stallWatchReset();
+
+void stallLoopBegin();
+void stallLoopStage(LoopStage stage);
+void stallLoopEnd();      // also feeds the task watchdog
+
+// Brackets one async_tcp handler invocation.
+struct StallNetScope {
+  explicit StallNetScope(NetStage stage);
+  ~StallNetScope();
+};
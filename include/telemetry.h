@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+class AsyncWebServer;
+class HitPipeline;
+
+// ---------------------------
+// TELEMETRY STREAM (/telemetry)
+// ---------------------------
+// Binary WebSocket on its own endpoint, so telemetry frames never queue
+// behind or in front of hits on /ws. Every TELEMETRY_PERIOD_MS one
+// delta-encoded record (telemetry_codec.h) is pushed to all clients.
+// A client may send "RATE <ms>" to change the period, clamped to
+// [TELEMETRY_MIN_PERIOD_MS, TELEMETRY_MAX_PERIOD_MS].
+//
+// Telemetry is strictly lower priority than hits: records are built in
+// loop() only once the camera UART is drained, and a record is dropped
+// (not queued) when any client still has unsent data.
+
+#ifndef TELEMETRY_PERIOD_MS
+#define TELEMETRY_PERIOD_MS 1000
+#endif
+
+#define TELEMETRY_MIN_PERIOD_MS 100
+#define TELEMETRY_MAX_PERIOD_MS 60000
+
+void telemetryBegin(AsyncWebServer& server, const HitPipeline& pipeline);
+
+// Call at the top of every loop() iteration (loop period / jitter).
+void telemetryLoopTick();
+
+// Call from loop() after the camera has been drained.
+void telemetryPoll();
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// TELEMETRY RECORDS
+// ---------------------------
+// Compact binary health records, delta-encoded against the previous one.
+// All integers are LEB128 varints, signed values zigzag-encoded.
+//
+//   key   : 0xA1, fieldCount, timeMs, value[0..fieldCount)
+//   delta : 0xA2, dtMs, changedMask, (value[i] - prev[i]) for each set bit
+//
+// A key record is sent first, every TELEM_KEYFRAME_EVERY records, and
+// whenever a new client joins. Decoders skip fields they don't know, so
+// fields may only ever be appended to the list below.
+
+enum TelemetryField {
+  TELEM_RSSI_DBM,
+  TELEM_CPU0_PCT,
+  TELEM_CPU1_PCT,
+  TELEM_LOOP_PERIOD_US,
+  TELEM_LOOP_JITTER_US,
+  TELEM_LOOP_MAX_US,
+  TELEM_CAM_RX_QUEUE,      // camera chunks waiting for loop() (camera_inputs.h)
+  TELEM_UDP_PENDING,       // hits with redundant copies still queued
+  TELEM_WS_CLIENTS,
+  TELEM_HEAP_FREE,
+  TELEM_HEAP_LARGEST,
+  TELEM_HEAP_MIN,
+  TELEM_CAM_LINES_PS,      // camera lines per second
+  TELEM_HITS,
+  TELEM_HITS_IGNORED,
+  TELEM_CAM_UNKNOWN,
+  TELEM_CAM_OVERFLOWS,
+  TELEM_HEAP_FAILED,
+  TELEM_FIELD_COUNT,
+};
+
+#define TELEM_REC_KEY         0xA1
+#define TELEM_REC_DELTA       0xA2
+#define TELEM_KEYFRAME_EVERY  30
+#define TELEM_RECORD_MAX      (1 + 5 + 5 + TELEM_FIELD_COUNT * 5)
+
+struct TelemetrySample {
+  uint32_t timeMs;
+  int32_t  values[TELEM_FIELD_COUNT];
+};
+
+const char* telemetryFieldName(int field);
+
+class TelemetryEncoder {
+public:
+  void forceKeyframe() { havePrev = false; }
+
+  // Returns the record length, or 0 if cap < TELEM_RECORD_MAX.
+  size_t encode(const TelemetrySample& s, uint8_t* out, size_t cap);
+
+private:
+  TelemetrySample prev = {};
+  bool     havePrev = false;
+  uint16_t sinceKey = 0;
+};
+
+class TelemetryDecoder {
+public:
+  // Returns false on a malformed record or a delta before any key.
+  bool decode(const uint8_t* data, size_t len, TelemetrySample& out);
+
+private:
+  TelemetrySample prev = {};
+  bool havePrev = false;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+
+// ---------------------------
+// UDP HIT CHANNEL
+// ---------------------------
+// Optional low-latency alternative to /ws: every hit is multicast (or
+// broadcast) as a HitPacket, repeated UDP_HIT_COPIES times spaced
+// UDP_HIT_COPY_SPACING_MS apart so a single lost datagram never loses
+// the hit. Receivers de-duplicate with HitReceiver (hit_packet.h).
+// During an authenticated match every copy carries the hit's tag.
+// Copies wait in a pooled RadioPacket (pools.h); with the pool dry only
+// copy 0 goes out.
+
+#ifndef UDP_HIT_ENABLED
+#define UDP_HIT_ENABLED 1
+#endif
+
+#ifndef UDP_HIT_PORT
+#define UDP_HIT_PORT 47100
+#endif
+
+// 239.13.37.1 — administratively scoped group
+#ifndef UDP_HIT_GROUP
+#define UDP_HIT_GROUP 239, 13, 37, 1
+#endif
+
+// 1 = send to the subnet broadcast address instead of the group
+#ifndef UDP_HIT_BROADCAST
+#define UDP_HIT_BROADCAST 0
+#endif
+
+#ifndef UDP_HIT_COPIES
+#define UDP_HIT_COPIES 3
+#endif
+
+#ifndef UDP_HIT_COPY_SPACING_MS
+#define UDP_HIT_COPY_SPACING_MS 4
+#endif
+
+void udpHitsBegin(uint16_t planeId);
+
+// Sends copy 0 immediately, the remaining copies from a timer.
+void udpHitsSend(uint32_t seq, uint32_t timeMs);
+
+// Hits that still have redundant copies waiting to go out.
+uint8_t udpHitsPending();
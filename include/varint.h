@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// ---------------------------
+// LEB128 VARINTS
+// ---------------------------
+// Unsigned values take 1..5 bytes; signed values are zigzag-encoded
+// first so small negative numbers stay small.
+
+#define VARINT_MAX 5
+
+inline size_t putVarint(uint8_t* out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+inline size_t putSignedVarint(uint8_t* out, int32_t v) {
+  return putVarint(out, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+// Advances p; returns false on truncated or over-long input.
+inline bool getVarint(const uint8_t*& p, const uint8_t* end, uint32_t& v) {
+  v = 0;
+  for (int shift = 0; shift < 35; shift += 7) {
+    if (p == end) return false;
+    uint8_t b = *p++;
+    v |= (uint32_t)(b & 0x7f) << shift;
+    if (!(b & 0x80)) return true;
+  }
+  return false;
+}
+
+inline bool getSignedVarint(const uint8_t*& p, const uint8_t* end, int32_t& v) {
+  uint32_t z;
+  if (!getVarint(p, end, z)) return false;
+  v = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+  return true;
+}
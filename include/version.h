@@ -0,0 +1,6 @@
+#pragma once
+
+// Bump on every firmware release; advertised over mDNS and /id.
+#ifndef FIRMWARE_VERSION
+#define FIRMWARE_VERSION "0.2.0"
+#endif
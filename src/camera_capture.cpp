@@ -0,0 +1,196 @@
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include <atomic>
+#include "camera_capture.h"
+#include "capture_format.h"
+#include "json_out.h"
+
+#define CAPTURE_FLUSH_CHUNK 1024
+#define CAPTURE_FLUSH_MS 50
+#define CAPTURE_STATUS_JSON_MAX 256
+
+// IDLE -> RUNNING (loop) -> STOPPING (loop) -> IDLE (flusher, file closed)
+enum CaptureState : uint8_t {
+  CAPTURE_IDLE,
+  CAPTURE_RUNNING,
+  CAPTURE_STOPPING,
+};
+
+static const char* const stateNames[] = { "idle", "recording", "stopping" };
+
+static uint8_t ringStorage[CAPTURE_RING_BYTES];
+static CaptureRing ring(ringStorage, sizeof(ringStorage));
+
+static std::atomic<uint8_t> state(CAPTURE_IDLE);
+static std::atomic<bool> wanted(false);
+static std::atomic<bool> fileFull(false);
+static std::atomic<uint32_t> fileBytes(0);
+
+static CaptureHeader header;
+static bool lastMatch = false;
+static bool fsReady = false;
+
+// ---------------------------
+// FLUSHER TASK (core 0)
+// ---------------------------
+static void flushTask(void*) {
+  static uint8_t chunk[CAPTURE_FLUSH_CHUNK];
+  File file;
+  bool open = false;
+
+  for (;;) {
+    uint8_t s = state.load();
+
+    if (s != CAPTURE_IDLE && !open) {
+      file = LittleFS.open(CAPTURE_PATH, "w");
+      open = true;
+      uint8_t hdr[CAPTURE_HEADER_SIZE];
+      encodeCaptureHeader(header, hdr);
+      file.write(hdr, sizeof(hdr));
+      fileBytes = sizeof(hdr);
+    }
+
+    size_t n;
+    while (open && (n = ring.read(chunk, sizeof(chunk))) > 0) {
+      if (fileBytes + n > CAPTURE_MAX_FILE_BYTES) {
+        fileFull = true;    // keep draining so the ring never backs up
+        continue;
+      }
+      file.write(chunk, n);
+      fileBytes += n;
+    }
+
+    // Ring was emptied after STOPPING was seen, so nothing is lost.
+    if (s == CAPTURE_STOPPING && open) {
+      file.close();
+      open = false;
+      state = CAPTURE_IDLE;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(CAPTURE_FLUSH_MS));
+  }
+}
+
+// ---------------------------
+// PRODUCER (loop)
+// ---------------------------
+void captureRequest(bool on) {
+  wanted = on;
+}
+
+static void appendMatchEdge(bool active, uint32_t nowUs) {
+  ring.append(nowUs, active ? CAPTURE_MATCH_START : CAPTURE_MATCH_END, 0, nullptr, 0);
+}
+
+void capturePoll(bool matchActive, uint32_t nowUs) {
+#if CAPTURE_ENABLED
+  if (!fsReady) return;
+
+#if CAPTURE_DURING_MATCH
+  if (matchActive != lastMatch) wanted = matchActive;
+#endif
+
+  uint8_t s = state.load();
+
+  if (s == CAPTURE_IDLE && wanted) {
+    fileFull = false;
+    header.startMs = millis();
+    ring.restart(nowUs);
+    appendMatchEdge(matchActive, nowUs);   // replay starts in the same state
+    state = CAPTURE_RUNNING;
+    Serial.println("🎞️ Camera capture started");
+  } else if (s == CAPTURE_RUNNING) {
+    if (matchActive != lastMatch) appendMatchEdge(matchActive, nowUs);
+    if (fileFull) wanted = false;   // stays off until asked again
+    if (!wanted) {
+      state = CAPTURE_STOPPING;
+      Serial.println("🎞️ Camera capture stopped");
+    }
+  }
+
+  lastMatch = matchActive;
+#endif
+}
+
+void captureCamera(uint8_t cam, const uint8_t* data, size_t len, uint32_t nowUs) {
+#if CAPTURE_ENABLED
+  if (state.load() != CAPTURE_RUNNING) return;
+  ring.append(nowUs, CAPTURE_BYTES, cam, data, len);
+#endif
+}
+
+void captureRelease(uint32_t cutoffUs) {
+#if CAPTURE_ENABLED
+  if (state.load() != CAPTURE_RUNNING) return;
+  ring.append(cutoffUs, CAPTURE_RELEASE, 0, nullptr, 0);
+#endif
+}
+
+// ---------------------------
+// HTTP
+// ---------------------------
+static void sendStatus(AsyncWebServerRequest* request) {
+  char json[CAPTURE_STATUS_JSON_MAX];
+  JsonOut j(json, sizeof(json));
+  j.beginObject();
+  j.field("state", stateNames[state.load()]);
+  j.field("file_bytes", fileBytes.load());
+  j.field("max_file_bytes", (uint32_t)CAPTURE_MAX_FILE_BYTES);
+  j.field("file_full", fileFull.load());
+  j.field("ring_used", (uint32_t)ring.used());
+  j.field("ring_bytes", (uint32_t)ring.capacity());
+  j.field("dropped", ring.dropped);
+  j.endObject();
+  if (!j.finish()) {
+    request->send(500, "text/plain", "capture status too large");
+    return;
+  }
+  request->send(200, "application/json", json);
+}
+
+void captureBegin(AsyncWebServer& server, uint16_t planeId) {
+#if CAPTURE_ENABLED
+  header.planeId = planeId;
+
+  if (!LittleFS.begin(true)) {
+    Serial.println("❌ LittleFS mount failed, capture disabled");
+    return;
+  }
+  fsReady = true;
+
+  xTaskCreatePinnedToCore(flushTask, "cam_capture", 4096, nullptr, 1, nullptr, 0);
+
+  server.on("/capture/start", HTTP_POST, [](AsyncWebServerRequest* request) {
+    captureRequest(true);
+    sendStatus(request);
+  });
+
+  server.on("/capture/stop", HTTP_POST, [](AsyncWebServerRequest* request) {
+    captureRequest(false);
+    sendStatus(request);
+  });
+
+  server.on("/capture/status", HTTP_GET, [](AsyncWebServerRequest* request) {
+    sendStatus(request);
+  });
+
+  // Registered last: "/capture" also matches every "/capture/..." URL.
+  server.on("/capture", HTTP_GET, [](AsyncWebServerRequest* request) {
+    if (state.load() != CAPTURE_IDLE) {
+      request->send(409, "text/plain", "capture in progress");
+      return;
+    }
+    if (!LittleFS.exists(CAPTURE_PATH)) {
+      request->send(404, "text/plain", "no capture");
+      return;
+    }
+    request->send(LittleFS, CAPTURE_PATH, "application/octet-stream", true);
+  });
+
+  Serial.print("🎞️ Camera capture ready, ring ");
+  Serial.print(CAPTURE_RING_BYTES);
+  Serial.println(" bytes");
+#endif
+}
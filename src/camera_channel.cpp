@@ -0,0 +1,197 @@
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <stdlib.h>
+#include "camera_channel.h"
+#include "camera_control.h"
+#include "camera_inputs.h"
+
+#define CAMERA_JSON_MAX 512
+
+static const CameraConfig bootConfig = {
+  false, { CAMERA_ROI }, CAMERA_EXPOSURE_US, CAMERA_THRESHOLD, CAMERA_MIN_BLOB_PX
+};
+
+struct CameraChannel {
+  CameraControl control;
+  CameraState   lastState;
+
+  // Last config asked for over POST /camera (async_tcp), applied by loop().
+  CameraConfig pending;
+  bool         pendingSet;
+};
+
+static CameraChannel channels[CAMERA_COUNT] = {
+  { CameraControl(bootConfig, CAMERA_PING_MS, CAMERA_HB_TIMEOUT_MS, CAMERA_CFG_RETRY_MS),
+    CAMERA_UNKNOWN, bootConfig, false },
+#if CAMERA_COUNT > 1
+  { CameraControl(bootConfig, CAMERA_PING_MS, CAMERA_HB_TIMEOUT_MS, CAMERA_CFG_RETRY_MS),
+    CAMERA_UNKNOWN, bootConfig, false },
+#endif
+};
+
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+
+// ---------------------------
+// LOOP SIDE
+// ---------------------------
+void cameraChannelSetMatch(bool match) {
+  for (CameraChannel& ch : channels) ch.control.setMatch(match);
+}
+
+void cameraChannelHeartbeat(uint8_t cam, const CameraHealth& health, uint32_t nowMs) {
+  if (cam < CAMERA_COUNT) channels[cam].control.onHeartbeat(health, nowMs);
+}
+
+static void pollChannel(uint8_t cam, uint32_t nowMs) {
+  CameraChannel& ch = channels[cam];
+  HardwareSerial* uart = cameraInputsUart(cam);
+  if (!uart) return;
+
+  CameraConfig update;
+  bool haveUpdate = false;
+  portENTER_CRITICAL(&pendingMux);
+  if (ch.pendingSet) {
+    update = ch.pending;
+    ch.pendingSet = false;
+    haveUpdate = true;
+  }
+  portEXIT_CRITICAL(&pendingMux);
+
+  if (haveUpdate) {
+    update.match = ch.control.config().match;   // match state is not the phone's to set here
+    ch.control.setConfig(update);
+  }
+
+  char line[CAMERA_CONTROL_LINE_MAX];
+  size_t n;
+  while ((n = ch.control.poll(nowMs, line, sizeof(line))) > 0) {
+    uart->write((const uint8_t*)line, n);
+  }
+
+  if (ch.control.state() != ch.lastState) {
+    if (ch.control.state() == CAMERA_DEAD) {
+      Serial.print("❌ Camera ");
+      Serial.print(cam);
+      Serial.println(" heartbeat lost");
+    } else if (ch.control.state() == CAMERA_ALIVE) {
+      Serial.print("📷 Camera ");
+      Serial.print(cam);
+      Serial.println(" alive");
+    }
+    ch.lastState = ch.control.state();
+  }
+}
+
+void cameraChannelPoll(uint32_t nowMs) {
+  for (uint8_t cam = 0; cam < CAMERA_COUNT; cam++) pollChannel(cam, nowMs);
+}
+
+static void writeChannel(JsonOut& j, uint8_t cam, uint32_t nowMs) {
+  j.field("cam", (uint32_t)cam);
+  channels[cam].control.writeJson(j, nowMs);
+}
+
+void cameraChannelWriteJson(JsonOut& j) {
+  uint32_t now = millis();
+  j.beginArray("camera");
+  for (uint8_t cam = 0; cam < CAMERA_COUNT; cam++) {
+    j.beginObject();
+    writeChannel(j, cam, now);
+    j.endObject();
+  }
+  j.endArray();
+}
+
+// ---------------------------
+// HTTP
+// ---------------------------
+static bool paramU32(AsyncWebServerRequest* request, const char* name, uint32_t& v) {
+  if (!request->hasParam(name, true)) return false;
+  v = strtoul(request->getParam(name, true)->value().c_str(), nullptr, 10);
+  return true;
+}
+
+static bool parseRoi(const char* s, CameraRoi& roi) {
+  uint32_t v[4];
+  char* end;
+  for (int i = 0; i < 4; i++) {
+    v[i] = strtoul(s, &end, 10);
+    if (end == s || v[i] > UINT16_MAX) return false;
+    if (i < 3 && *end++ != ',') return false;
+    s = end;
+  }
+  if (*end != '\0' || v[2] == 0 || v[3] == 0) return false;
+
+  roi = { (uint16_t)v[0], (uint16_t)v[1], (uint16_t)v[2], (uint16_t)v[3] };
+  return true;
+}
+
+// cam=N picks the camera, default 0 (the nose camera).
+static bool paramCam(AsyncWebServerRequest* request, bool post, uint8_t& cam) {
+  cam = 0;
+  if (!request->hasParam("cam", post)) return true;
+  uint32_t v = strtoul(request->getParam("cam", post)->value().c_str(), nullptr, 10);
+  if (v >= CAMERA_COUNT) return false;
+  cam = (uint8_t)v;
+  return true;
+}
+
+static void sendCamera(AsyncWebServerRequest* request, uint8_t cam) {
+  char json[CAMERA_JSON_MAX];
+  JsonOut j(json, sizeof(json));
+  j.beginObject();
+  writeChannel(j, cam, millis());
+  j.endObject();
+  if (!j.finish()) {
+    request->send(500, "text/plain", "camera status too large");
+    return;
+  }
+  request->send(200, "application/json", json);
+}
+
+void cameraChannelBegin(AsyncWebServer& server, bool match) {
+  cameraChannelSetMatch(match);
+
+  server.on("/camera", HTTP_GET, [](AsyncWebServerRequest* request) {
+    uint8_t cam;
+    if (!paramCam(request, false, cam)) {
+      request->send(400, "text/plain", "no such cam");
+      return;
+    }
+    sendCamera(request, cam);
+  });
+
+  server.on("/camera", HTTP_POST, [](AsyncWebServerRequest* request) {
+    uint8_t cam;
+    if (!paramCam(request, true, cam)) {
+      request->send(400, "text/plain", "no such cam");
+      return;
+    }
+    CameraChannel& ch = channels[cam];
+
+    portENTER_CRITICAL(&pendingMux);
+    CameraConfig c = ch.pending;
+    portEXIT_CRITICAL(&pendingMux);
+
+    uint32_t v;
+    if (request->hasParam("roi", true) &&
+        !parseRoi(request->getParam("roi", true)->value().c_str(), c.roi)) {
+      request->send(400, "text/plain", "roi=x,y,w,h");
+      return;
+    }
+    if (paramU32(request, "exposure_us", v)) c.exposureUs = v;
+    if (paramU32(request, "threshold", v)) c.threshold = (uint16_t)v;
+    if (paramU32(request, "min_blob_px", v)) c.minBlobPx = (uint16_t)v;
+
+    portENTER_CRITICAL(&pendingMux);
+    ch.pending = c;
+    ch.pendingSet = true;
+    portEXIT_CRITICAL(&pendingMux);
+
+    sendCamera(request, cam);
+  });
+
+  Serial.print("📷 Camera control channel on every camera UART: ");
+  Serial.println(CAMERA_COUNT);
+}
@@ -0,0 +1,103 @@
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "camera_inputs.h"
+#include "camera_capture.h"
+#include "spsc_queue.h"
+
+static_assert(CAMERA_COUNT >= 1 && CAMERA_COUNT <= 2, "one nose + optional tail camera");
+
+struct CameraChunk {
+  uint64_t timeUs;
+  uint8_t  len;
+  uint8_t  data[CAMERA_CHUNK_BYTES];
+};
+
+struct CameraInput {
+  HardwareSerial* uart;
+  SpscQueue<CameraChunk, CAMERA_CHUNK_QUEUE> queue;
+  uint32_t droppedBytes;   // queue full (UART task side)
+};
+
+static CameraInput inputs[CAMERA_COUNT];
+
+// ---------------------------
+// UART TASK SIDE
+// ---------------------------
+static void onCameraBytes(uint8_t cam) {
+  CameraInput& in = inputs[cam];
+  uint64_t now = esp_timer_get_time();
+  CameraChunk chunk;
+
+  while (in.uart->available() > 0) {
+    chunk.timeUs = now;
+    chunk.len = (uint8_t)in.uart->read(chunk.data, sizeof(chunk.data));
+    if (chunk.len == 0) break;
+    if (!in.queue.push(chunk)) in.droppedBytes += chunk.len;
+  }
+}
+
+// ---------------------------
+// PUBLIC API
+// ---------------------------
+void cameraInputsBegin() {
+  inputs[0].uart = &Serial2;
+  Serial2.begin(115200, SERIAL_8N1, CAM_RX, CAM_TX);
+  Serial2.onReceive([]() { onCameraBytes(0); });
+
+#if CAMERA_COUNT > 1
+  inputs[1].uart = &Serial1;
+  Serial1.begin(115200, SERIAL_8N1, CAM2_RX, CAM2_TX);
+  Serial1.onReceive([]() { onCameraBytes(1); });
+#endif
+
+  Serial.print("📷 Cameras: ");
+  Serial.println(CAMERA_COUNT);
+}
+
+void cameraInputsPoll(HitPipeline& pipeline) {
+  uint64_t cutoff = esp_timer_get_time() - CAMERA_MERGE_HOLD_US;
+  CameraChunk chunk;
+
+  for (uint8_t cam = 0; cam < CAMERA_COUNT; cam++) {
+    while (inputs[cam].queue.pop(chunk)) {
+      captureCamera(cam, chunk.data, chunk.len, (uint32_t)chunk.timeUs);
+      pipeline.feedCamera(cam, chunk.data, chunk.len, chunk.timeUs);
+    }
+  }
+
+  // Only releases that took something out of the merge are recorded;
+  // the rest change nothing replay could see.
+  size_t waiting = pipeline.merger().pending();
+  pipeline.releaseHits(cutoff);
+  if (pipeline.merger().pending() != waiting) captureRelease((uint32_t)cutoff);
+}
+
+HardwareSerial* cameraInputsUart(uint8_t cam) {
+  return cam < CAMERA_COUNT ? inputs[cam].uart : nullptr;
+}
+
+uint32_t cameraInputsPending() {
+  uint32_t n = 0;
+  for (uint8_t cam = 0; cam < CAMERA_COUNT; cam++) n += (uint32_t)inputs[cam].queue.size();
+  return n;
+}
+
+void cameraInputsWriteJson(JsonOut& j, const HitPipeline& pipeline) {
+  j.beginArray("cameras");
+  for (uint8_t cam = 0; cam < CAMERA_COUNT; cam++) {
+    const CameraInputStats& s = pipeline.input(cam);
+    j.beginObject();
+    j.field("cam", (uint32_t)cam);
+    j.field("bytes", s.bytes);
+    j.field("lines", s.lines);
+    j.field("hits", s.hits);
+    j.field("duplicates", pipeline.merger().duplicates[cam]);
+    j.field("unknown", s.unknown);
+    j.field("overflows", pipeline.reader(cam).overflows);
+    j.field("heartbeats", s.heartbeats);
+    j.field("bad_heartbeats", s.badHeartbeats);
+    j.field("dropped_bytes", inputs[cam].droppedBytes);
+    j.endObject();
+  }
+  j.endArray();
+}
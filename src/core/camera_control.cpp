@@ -0,0 +1,166 @@
+#include <string.h>
+#include "camera_control.h"
+
+static const char* const stateNames[] = { "unknown", "alive", "dead" };
+
+// ---------------------------
+// LINE BUILDING
+// ---------------------------
+struct LineOut {
+  char*  out;
+  size_t cap;
+  size_t len;
+  bool   ok;
+
+  void raw(const char* s) {
+    size_t n = strlen(s);
+    if (!ok || len + n >= cap) {
+      ok = false;
+      return;
+    }
+    memcpy(out + len, s, n);
+    len += n;
+  }
+
+  void num(uint32_t v) {
+    char tmp[12];
+    char* p = tmp + sizeof(tmp) - 1;
+    *p = '\0';
+    do {
+      *--p = (char)('0' + v % 10);
+      v /= 10;
+    } while (v);
+    raw(" ");
+    raw(p);
+  }
+
+  size_t finish() {
+    raw("\n");
+    if (!ok) return 0;
+    out[len] = '\0';
+    return len;
+  }
+};
+
+// ---------------------------
+// SETTINGS
+// ---------------------------
+CameraControl::CameraControl(const CameraConfig& initial, uint32_t pingMs,
+                             uint32_t timeoutMs, uint32_t retryMs)
+  : cfg(initial), pingMs(pingMs), timeoutMs(timeoutMs), retryMs(retryMs) {}
+
+void CameraControl::changed() {
+  gen++;
+  if (gen == 0) gen = 1;   // 0 is the camera's "never configured"
+  cfgDue = true;
+}
+
+void CameraControl::setMatch(bool match) {
+  if (cfg.match == match) return;
+  cfg.match = match;
+  changed();
+}
+
+void CameraControl::setRoi(const CameraRoi& roi) {
+  cfg.roi = roi;
+  changed();
+}
+
+void CameraControl::setExposure(uint32_t exposureUs) {
+  cfg.exposureUs = exposureUs;
+  changed();
+}
+
+void CameraControl::setThresholds(uint16_t threshold, uint16_t minBlobPx) {
+  cfg.threshold = threshold;
+  cfg.minBlobPx = minBlobPx;
+  changed();
+}
+
+void CameraControl::setConfig(const CameraConfig& c) {
+  cfg = c;
+  changed();
+}
+
+// ---------------------------
+// HEALTH
+// ---------------------------
+void CameraControl::onHeartbeat(const CameraHealth& h, uint32_t nowMs) {
+  // Camera rebooted or lost a CFG: resend now instead of after retryMs.
+  if (h.cfgGen != gen && last.cfgGen == gen) cfgDue = true;
+
+  if (st == CAMERA_DEAD) revivals++;
+  st = CAMERA_ALIVE;
+  last = h;
+  lastHeardMs = nowMs;
+}
+
+size_t CameraControl::poll(uint32_t nowMs, char* out, size_t cap) {
+  if (!started) {
+    started = true;
+    startMs = nowMs;
+    lastPingMs = nowMs - pingMs;   // ping right away
+  }
+
+  int32_t since = (int32_t)(nowMs - (st == CAMERA_UNKNOWN ? startMs : lastHeardMs));
+  if (st != CAMERA_DEAD && since > (int32_t)timeoutMs) {
+    st = CAMERA_DEAD;
+    deaths++;
+  }
+
+  LineOut line = { out, cap, 0, true };
+
+  bool stale = (st == CAMERA_ALIVE) && last.cfgGen != gen;
+  if (cfgDue || (stale && nowMs - lastCfgMs >= retryMs)) {
+    line.raw("CFG");
+    line.num(gen);
+    line.raw(cfg.match ? " MATCH" : " IDLE");
+    line.num(cfg.roi.x);
+    line.num(cfg.roi.y);
+    line.num(cfg.roi.w);
+    line.num(cfg.roi.h);
+    line.num(cfg.exposureUs);
+    line.num(cfg.threshold);
+    line.num(cfg.minBlobPx);
+    cfgDue = false;
+    lastCfgMs = nowMs;
+    configsSent++;
+    return line.finish();
+  }
+
+  if (nowMs - lastPingMs >= pingMs) {
+    line.raw("PING");
+    lastPingMs = nowMs;
+    pingsSent++;
+    return line.finish();
+  }
+
+  return 0;
+}
+
+void CameraControl::writeJson(JsonOut& j, uint32_t nowMs) const {
+  j.field("state", stateNames[st]);
+  j.field("config_gen", gen);
+  j.field("config_applied", configApplied());
+  j.field("last_heard_ms", st == CAMERA_UNKNOWN ? (uint32_t)0 : nowMs - lastHeardMs);
+  j.field("fps_x10", (uint32_t)last.fpsX10);
+  j.field("temp_x10", (int32_t)last.tempX10);
+  j.field("dropped_frames", last.dropped);
+  j.field("deaths", deaths);
+  j.field("revivals", revivals);
+  j.field("configs_sent", configsSent);
+  j.field("pings_sent", pingsSent);
+
+  j.beginObject("config");
+  j.field("mode", cfg.match ? "match" : "idle");
+  j.beginArray("roi");
+  j.value((uint32_t)cfg.roi.x);
+  j.value((uint32_t)cfg.roi.y);
+  j.value((uint32_t)cfg.roi.w);
+  j.value((uint32_t)cfg.roi.h);
+  j.endArray();
+  j.field("exposure_us", cfg.exposureUs);
+  j.field("threshold", (uint32_t)cfg.threshold);
+  j.field("min_blob_px", (uint32_t)cfg.minBlobPx);
+  j.endObject();
+}
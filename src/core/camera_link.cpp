@@ -0,0 +1,100 @@
+#include <string.h>
+#include "camera_link.h"
+
+static bool isSpace(uint8_t c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+// ---------------------------
+// LINE ASSEMBLY
+// ---------------------------
+bool CameraLineReader::feed(uint8_t c) {
+  if (complete) {
+    complete = false;
+    len = 0;
+  }
+
+  if (c == '\n') {
+    if (discarding) {
+      discarding = false;
+      len = 0;
+      return false;
+    }
+    while (len > 0 && isSpace((uint8_t)buf[len - 1])) len--;
+    buf[len] = '\0';
+    complete = (len > 0);
+    return complete;
+  }
+
+  if (discarding) return false;
+  if (len == 0 && isSpace(c)) return false;
+
+  if (len == CAMERA_LINE_MAX) {
+    overflows++;
+    discarding = true;
+    len = 0;
+    return false;
+  }
+
+  buf[len++] = (char)c;
+  return false;
+}
+
+// ---------------------------
+// MESSAGE CLASSIFICATION
+// ---------------------------
+CameraMsg parseCameraLine(const char* line, size_t len) {
+  if (len == 0) return CAM_MSG_NONE;
+  if (len == 3 && memcmp(line, "HIT", 3) == 0) return CAM_MSG_HIT;
+  if (len > 3 && memcmp(line, "HB ", 3) == 0) return CAM_MSG_HEARTBEAT;
+  return CAM_MSG_UNKNOWN;
+}
+
+// ---------------------------
+// HEARTBEAT
+// ---------------------------
+// Reads one space-separated integer; p is left after it.
+static bool nextInt(const char*& p, const char* end, int64_t& v) {
+  while (p < end && *p == ' ') p++;
+
+  bool neg = false;
+  if (p < end && *p == '-') {
+    neg = true;
+    p++;
+  }
+
+  const char* start = p;
+  v = 0;
+  while (p < end && *p >= '0' && *p <= '9' && p - start < 10) v = v * 10 + (*p++ - '0');
+  if (p == start || (p < end && *p != ' ')) return false;
+
+  if (neg) v = -v;
+  return true;
+}
+
+bool parseCameraHeartbeat(const char* line, size_t len, CameraHealth& h) {
+  if (parseCameraLine(line, len) != CAM_MSG_HEARTBEAT) return false;
+
+  const char* p = line + 3;
+  const char* end = line + len;
+  int64_t gen, fps, temp, dropped;
+
+  if (!nextInt(p, end, gen) || !nextInt(p, end, fps) ||
+      !nextInt(p, end, temp) || !nextInt(p, end, dropped)) {
+    return false;
+  }
+  while (p < end && *p == ' ') p++;
+  if (p != end) {
+    return false;
+  }
+  if (gen < 0 || gen > UINT32_MAX || fps < 0 || fps > UINT16_MAX ||
+      temp < INT16_MIN || temp > INT16_MAX || dropped < 0 || dropped > UINT32_MAX) {
+    return false;
+  }
+
+  h.cfgGen = (uint32_t)gen;
+  h.fpsX10 = (uint16_t)fps;
+  h.tempX10 = (int16_t)temp;
+  h.dropped = (uint32_t)dropped;
+  return true;
+}
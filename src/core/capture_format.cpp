@@ -0,0 +1,122 @@
+#include <string.h>
+#include "capture_format.h"
+#include "varint.h"
+
+// "ADCAP" + version digit
+static const char magic[5] = { 'A', 'D', 'C', 'A', 'P' };
+
+// ---------------------------
+// HEADER
+// ---------------------------
+void encodeCaptureHeader(const CaptureHeader& h, uint8_t* out) {
+  memcpy(out, magic, sizeof(magic));
+  out[5] = '0' + CAPTURE_VERSION;
+  out[6] = (uint8_t)h.planeId;
+  out[7] = (uint8_t)(h.planeId >> 8);
+  for (int i = 0; i < 4; i++) out[8 + i] = (uint8_t)(h.startMs >> (8 * i));
+  memset(out + 12, 0, 4);
+}
+
+bool decodeCaptureHeader(const uint8_t* data, size_t len, CaptureHeader& h) {
+  if (len < CAPTURE_HEADER_SIZE || memcmp(data, magic, sizeof(magic)) != 0) return false;
+  if (data[5] < '1' || data[5] > '0' + CAPTURE_VERSION) return false;
+  h.version = (uint8_t)(data[5] - '0');
+  h.planeId = (uint16_t)(data[6] | (data[7] << 8));
+  h.startMs = 0;
+  for (int i = 0; i < 4; i++) h.startMs |= (uint32_t)data[8 + i] << (8 * i);
+  return true;
+}
+
+// ---------------------------
+// READER
+// ---------------------------
+bool CaptureReader::next(CaptureRecord& r) {
+  if (p == end) return false;
+
+  int32_t dt;
+  uint32_t tag;
+  bool ok;
+  if (version >= 2) {
+    ok = getSignedVarint(p, end, dt) && getVarint(p, end, tag);
+  } else {
+    uint32_t udt;
+    ok = getVarint(p, end, udt) && getVarint(p, end, tag);
+    dt = (int32_t)udt;
+    ok = ok && (tag & 3) <= CAPTURE_MATCH_END;
+    tag = (tag >> 2) << 4 | (tag & 3);   // camera 0
+  }
+  if (!ok) {
+    truncated = true;
+    return false;
+  }
+
+  size_t len = tag >> 4;
+  if ((size_t)(end - p) < len) {
+    truncated = true;
+    return false;
+  }
+
+  timeUs += dt;
+  r.timeUs = timeUs;
+  r.kind = (CaptureKind)(tag & 3);
+  r.cam = (uint8_t)((tag >> 2) & 3);
+  r.data = p;
+  r.len = len;
+  p += len;
+  return true;
+}
+
+// ---------------------------
+// RING
+// ---------------------------
+void CaptureRing::restart(uint32_t nowUs) {
+  head.store(0, std::memory_order_relaxed);
+  tail.store(0, std::memory_order_relaxed);
+  lastUs = nowUs;
+  dropped = 0;
+}
+
+size_t CaptureRing::used() const {
+  return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+}
+
+void CaptureRing::put(const uint8_t* src, size_t n, size_t at) {
+  size_t off = at % cap;
+  size_t first = (n < cap - off) ? n : cap - off;
+  memcpy(buf + off, src, first);
+  memcpy(buf, src + first, n - first);
+}
+
+bool CaptureRing::append(uint32_t nowUs, CaptureKind kind, uint8_t cam, const uint8_t* data,
+                         size_t len) {
+  uint8_t hdr[CAPTURE_RECORD_OVERHEAD];
+  size_t n = putSignedVarint(hdr, (int32_t)(nowUs - lastUs));
+  n += putVarint(hdr + n, (uint32_t)(len << 4) | (uint32_t)(cam & 3) << 2 | kind);
+
+  size_t h = head.load(std::memory_order_relaxed);
+  size_t free = cap - (h - tail.load(std::memory_order_acquire));
+  if (n + len > free) {
+    dropped++;
+    return false;
+  }
+
+  put(hdr, n, h);
+  if (len) put(data, len, h + n);
+  head.store(h + n + len, std::memory_order_release);
+  lastUs = nowUs;
+  return true;
+}
+
+size_t CaptureRing::read(uint8_t* out, size_t max) {
+  size_t t = tail.load(std::memory_order_relaxed);
+  size_t avail = head.load(std::memory_order_acquire) - t;
+  size_t n = avail < max ? avail : max;
+  if (n == 0) return 0;
+
+  size_t off = t % cap;
+  size_t first = (n < cap - off) ? n : cap - off;
+  memcpy(out, buf + off, first);
+  memcpy(out + first, buf, n - first);
+  tail.store(t + n, std::memory_order_release);
+  return n;
+}
@@ -0,0 +1,42 @@
+#include <string.h>
+#include "commands.h"
+
+struct CommandName {
+  const char*  text;
+  size_t       len;
+  PhoneCommand cmd;
+};
+
+static const CommandName commandNames[] = {
+  { "MATCH_START", 11, CMD_MATCH_START },
+  { "MATCH_END",    9, CMD_MATCH_END },
+};
+
+static bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+PhoneCommand parseCommand(const char* data, size_t len) {
+  while (len > 0 && isSpace(*data)) { data++; len--; }
+  while (len > 0 && isSpace(data[len - 1])) len--;
+
+  for (const CommandName& c : commandNames) {
+    if (c.len == len && memcmp(c.text, data, len) == 0) return c.cmd;
+  }
+  return CMD_UNKNOWN;
+}
+
+bool parseSyncCommand(const char* data, size_t len, uint32_t& since) {
+  while (len > 0 && isSpace(*data)) { data++; len--; }
+  while (len > 0 && isSpace(data[len - 1])) len--;
+  if (len < 6 || memcmp(data, "SYNC ", 5) != 0) return false;
+
+  uint64_t v = 0;
+  for (size_t i = 5; i < len; i++) {
+    if (data[i] < '0' || data[i] > '9') return false;
+    v = v * 10 + (uint64_t)(data[i] - '0');
+    if (v > UINT32_MAX) return false;
+  }
+  since = (uint32_t)v;
+  return true;
+}
@@ -0,0 +1,39 @@
+#include "hit_merge.h"
+
+bool HitMerger::push(const CameraDetection& d) {
+  if (count == HIT_MERGE_MAX) {
+    overflows++;
+    return false;
+  }
+  if (released && d.timeUs < last.timeUs) late++;
+
+  // Insertion sort: the list is short and nearly always in order already.
+  size_t i = count;
+  while (i > 0 && waiting[i - 1].timeUs > d.timeUs) {
+    waiting[i] = waiting[i - 1];
+    i--;
+  }
+  waiting[i] = d;
+  count++;
+  return true;
+}
+
+bool HitMerger::pop(uint64_t cutoffUs, CameraDetection& out) {
+  while (count > 0 && waiting[0].timeUs <= cutoffUs) {
+    CameraDetection d = waiting[0];
+    for (size_t i = 1; i < count; i++) waiting[i - 1] = waiting[i];
+    count--;
+
+    uint64_t apart = d.timeUs >= last.timeUs ? d.timeUs - last.timeUs : last.timeUs - d.timeUs;
+    if (released && d.cam != last.cam && apart < dedupUs) {
+      if (d.cam < HIT_CAMERAS_MAX) duplicates[d.cam]++;
+      continue;
+    }
+
+    released = true;
+    last = d;
+    out = d;
+    return true;
+  }
+  return false;
+}
@@ -0,0 +1,124 @@
+#include "hit_packet.h"
+
+static void put16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ---------------------------
+// ENCODE / DECODE
+// ---------------------------
+void encodeHitPacket(const HitPacket& pkt, uint8_t* out) {
+  out[0] = 'A';
+  out[1] = 'D';
+  out[2] = HIT_PACKET_VERSION;
+  out[3] = pkt.type;
+  put16(out + 4, pkt.planeId);
+  put16(out + 6, pkt.bootId);
+  put32(out + 8, pkt.seq);
+  put32(out + 12, pkt.timeMs);
+  out[16] = pkt.copy;
+  out[17] = pkt.copies;
+  put16(out + 18, 0);
+}
+
+bool decodeHitPacket(const uint8_t* data, size_t len, HitPacket& pkt) {
+  if (len < HIT_PACKET_SIZE) return false;
+  if (data[0] != 'A' || data[1] != 'D') return false;
+  if (data[2] != HIT_PACKET_VERSION) return false;
+
+  pkt.type    = data[3];
+  pkt.planeId = get16(data + 4);
+  pkt.bootId  = get16(data + 6);
+  pkt.seq     = get32(data + 8);
+  pkt.timeMs  = get32(data + 12);
+  pkt.copy    = data[16];
+  pkt.copies  = data[17];
+  return true;
+}
+
+// ---------------------------
+// SEQUENCE WINDOW
+// ---------------------------
+void SeqWindow::reset() {
+  high = 0;
+  seen = 0;
+  started = false;
+}
+
+bool SeqWindow::accept(uint32_t seq) {
+  if (!started) {
+    started = true;
+    high = seq;
+    seen = 1;
+    return true;
+  }
+
+  if ((int32_t)(seq - high) > 0) {
+    uint32_t shift = seq - high;
+    seen = (shift >= 64) ? 0 : (seen << shift);
+    seen |= 1;
+    high = seq;
+    return true;
+  }
+
+  uint32_t back = high - seq;
+  if (back >= 64) return false;
+
+  uint64_t bit = (uint64_t)1 << back;
+  if (seen & bit) return false;
+  seen |= bit;
+  return true;
+}
+
+// ---------------------------
+// HIT RECEIVER
+// ---------------------------
+bool HitReceiver::accept(const HitPacket& pkt) {
+  Slot* free = nullptr;
+
+  for (Slot& s : slots) {
+    if (!s.used) {
+      if (!free) free = &s;
+      continue;
+    }
+    if (s.planeId != pkt.planeId) continue;
+
+    // Plane rebooted: its sequence starts over.
+    if (s.bootId != pkt.bootId) {
+      s.bootId = pkt.bootId;
+      s.window.reset();
+    }
+
+    if (s.window.accept(pkt.seq)) return true;
+    duplicates++;
+    return false;
+  }
+
+  if (!free) {
+    droppedPlanes++;
+    return false;
+  }
+
+  free->used = true;
+  free->planeId = pkt.planeId;
+  free->bootId = pkt.bootId;
+  free->window.reset();
+  return free->window.accept(pkt.seq);
+}
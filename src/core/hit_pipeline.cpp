@@ -0,0 +1,72 @@
+#include "hit_pipeline.h"
+
+uint32_t HitPipeline::feedCamera(uint8_t cam, const uint8_t* data, size_t len,
+                                 uint64_t arrivalUs) {
+  if (cam >= HIT_CAMERAS_MAX) return 0;
+  CameraLineReader& reader = lines[cam];
+  CameraInputStats& in = stats[cam];
+  uint32_t detected = 0;
+
+  in.bytes += (uint32_t)len;
+
+  for (size_t i = 0; i < len; i++) {
+    if (!reader.feed(data[i])) continue;
+    camLines++;
+    in.lines++;
+
+    CameraMsg msg = parseCameraLine(reader.line(), reader.length());
+
+    if (msg == CAM_MSG_HEARTBEAT) {
+      CameraHealth health;
+      if (!parseCameraHeartbeat(reader.line(), reader.length(), health)) {
+        badHeartbeats++;
+        in.badHeartbeats++;
+        continue;
+      }
+      heartbeats++;
+      in.heartbeats++;
+      if (heartbeatSink) heartbeatSink(cam, health, (uint32_t)(arrivalUs / 1000));
+      continue;
+    }
+
+    if (msg != CAM_MSG_HIT) {
+      unknownLines++;
+      in.unknown++;
+      continue;
+    }
+
+    if (!matchActive) {
+      hitsIgnored++;
+      continue;
+    }
+
+    in.hits++;
+    CameraDetection d = { arrivalUs, cam };
+    if (merge.push(d)) detected++;
+  }
+  return detected;
+}
+
+uint32_t HitPipeline::releaseHits(uint64_t cutoffUs) {
+  uint32_t sent = 0;
+  CameraDetection d;
+
+  while (merge.pop(cutoffUs, d)) {
+    HitEvent hit = { ++seq, (uint32_t)(d.timeUs / 1000) };
+    if (sink) sink(hit);
+    sent++;
+  }
+  return sent;
+}
+
+uint32_t HitPipeline::feedCamera(const uint8_t* data, size_t len, uint32_t nowMs) {
+  uint64_t nowUs = (uint64_t)nowMs * 1000;
+  feedCamera(0, data, len, nowUs);
+  return releaseHits(nowUs);
+}
+
+uint32_t HitPipeline::overflows() const {
+  uint32_t n = 0;
+  for (const CameraLineReader& r : lines) n += r.overflows;
+  return n;
+}
@@ -0,0 +1,190 @@
+#include <string.h>
+#include "hmac_sha256.h"
+
+static const uint32_t K[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static inline uint32_t rotr(uint32_t x, int n) {
+  return (x >> n) | (x << (32 - n));
+}
+
+// ---------------------------
+// SHA-256 (software)
+// ---------------------------
+void Sha256::reset() {
+  static const uint32_t init[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+  };
+  memcpy(h, init, sizeof(h));
+  total = 0;
+  used = 0;
+}
+
+void Sha256::compress(const uint8_t* p) {
+  uint32_t w[64];
+  for (int i = 0; i < 16; i++) {
+    w[i] = ((uint32_t)p[4 * i] << 24) | ((uint32_t)p[4 * i + 1] << 16) |
+           ((uint32_t)p[4 * i + 2] << 8) | p[4 * i + 3];
+  }
+  for (int i = 16; i < 64; i++) {
+    uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+    uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3];
+  uint32_t e = h[4], f = h[5], g = h[6], k = h[7];
+
+  for (int i = 0; i < 64; i++) {
+    uint32_t t1 = k + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + K[i] + w[i];
+    uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+    k = g; g = f; f = e; e = d + t1;
+    d = c; c = b; b = a; a = t1 + t2;
+  }
+
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+  h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+}
+
+void Sha256::update(const uint8_t* data, size_t len) {
+  total += len;
+
+  if (used > 0) {
+    size_t n = SHA256_BLOCK - used < len ? SHA256_BLOCK - used : len;
+    memcpy(buf + used, data, n);
+    used += n;
+    data += n;
+    len -= n;
+    if (used < SHA256_BLOCK) return;
+    compress(buf);
+    used = 0;
+  }
+
+  while (len >= SHA256_BLOCK) {
+    compress(data);
+    data += SHA256_BLOCK;
+    len -= SHA256_BLOCK;
+  }
+
+  memcpy(buf, data, len);
+  used = len;
+}
+
+void Sha256::finish(uint8_t out[SHA256_BYTES]) {
+  uint64_t bits = total * 8;
+
+  buf[used++] = 0x80;
+  if (used > SHA256_BLOCK - 8) {
+    memset(buf + used, 0, SHA256_BLOCK - used);
+    compress(buf);
+    used = 0;
+  }
+  memset(buf + used, 0, SHA256_BLOCK - 8 - used);
+  for (int i = 0; i < 8; i++) buf[SHA256_BLOCK - 1 - i] = (uint8_t)(bits >> (8 * i));
+  compress(buf);
+
+  for (int i = 0; i < 8; i++) {
+    out[4 * i]     = (uint8_t)(h[i] >> 24);
+    out[4 * i + 1] = (uint8_t)(h[i] >> 16);
+    out[4 * i + 2] = (uint8_t)(h[i] >> 8);
+    out[4 * i + 3] = (uint8_t)h[i];
+  }
+}
+
+void sha256(const uint8_t* data, size_t len, uint8_t out[SHA256_BYTES]) {
+  Sha256 s;
+  s.update(data, len);
+  s.finish(out);
+}
+
+// ---------------------------
+// HMAC
+// ---------------------------
+HmacSha256::HmacSha256(HmacBackend b) : mode(b) {
+#ifdef ARDUINO
+  mbedtls_sha256_init(&hwInner);
+  mbedtls_sha256_init(&hwOuter);
+#endif
+}
+
+HmacSha256::~HmacSha256() {
+#ifdef ARDUINO
+  mbedtls_sha256_free(&hwInner);
+  mbedtls_sha256_free(&hwOuter);
+#endif
+}
+
+void HmacSha256::setKey(const uint8_t* key, size_t len) {
+  uint8_t k[SHA256_BLOCK] = {};
+  if (len > SHA256_BLOCK) sha256(key, len, k);
+  else memcpy(k, key, len);
+
+  uint8_t ipad[SHA256_BLOCK], opad[SHA256_BLOCK];
+  for (int i = 0; i < SHA256_BLOCK; i++) {
+    ipad[i] = k[i] ^ 0x36;
+    opad[i] = k[i] ^ 0x5c;
+  }
+
+  inner.reset();
+  inner.update(ipad, sizeof(ipad));
+  outer.reset();
+  outer.update(opad, sizeof(opad));
+
+#ifdef ARDUINO
+  mbedtls_sha256_starts(&hwInner, 0);
+  mbedtls_sha256_update(&hwInner, ipad, sizeof(ipad));
+  mbedtls_sha256_starts(&hwOuter, 0);
+  mbedtls_sha256_update(&hwOuter, opad, sizeof(opad));
+#endif
+
+  memset(k, 0, sizeof(k));
+  keyed = true;
+}
+
+void HmacSha256::mac2(const uint8_t* a, size_t aLen, const uint8_t* b, size_t bLen,
+                      uint8_t out[SHA256_BYTES]) const {
+  uint8_t ih[SHA256_BYTES];
+
+#ifdef ARDUINO
+  if (mode == HMAC_HARDWARE) {
+    mbedtls_sha256_context c;
+    mbedtls_sha256_init(&c);
+    mbedtls_sha256_clone(&c, &hwInner);
+    mbedtls_sha256_update(&c, a, aLen);
+    if (bLen) mbedtls_sha256_update(&c, b, bLen);
+    mbedtls_sha256_finish(&c, ih);
+    mbedtls_sha256_clone(&c, &hwOuter);
+    mbedtls_sha256_update(&c, ih, sizeof(ih));
+    mbedtls_sha256_finish(&c, out);
+    mbedtls_sha256_free(&c);
+    return;
+  }
+#endif
+
+  Sha256 s = inner;
+  s.update(a, aLen);
+  if (bLen) s.update(b, bLen);
+  s.finish(ih);
+  s = outer;
+  s.update(ih, sizeof(ih));
+  s.finish(out);
+}
+
+void HmacSha256::mac(const uint8_t* msg, size_t len, uint8_t out[SHA256_BYTES]) const {
+  mac2(msg, len, nullptr, 0, out);
+}
+
+bool macEqual(const uint8_t* a, const uint8_t* b, size_t len) {
+  uint8_t diff = 0;
+  for (size_t i = 0; i < len; i++) diff |= (uint8_t)(a[i] ^ b[i]);
+  return diff == 0;
+}
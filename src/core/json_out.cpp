@@ -0,0 +1,91 @@
+#include <string.h>
+#include "json_out.h"
+
+JsonOut::JsonOut(char* out, size_t cap) : out(out), cap(cap), ok(cap > 0) {}
+
+void JsonOut::raw(const char* s) {
+  size_t n = strlen(s);
+  if (!ok || len + n >= cap) { ok = false; return; }
+  memcpy(out + len, s, n);
+  len += n;
+}
+
+void JsonOut::ch(char c) {
+  if (!ok || len + 1 >= cap) { ok = false; return; }
+  out[len++] = c;
+}
+
+void JsonOut::str(const char* s) {
+  static const char hex[] = "0123456789abcdef";
+  ch('"');
+  for (; *s; s++) {
+    unsigned char c = (unsigned char)*s;
+    if (c == '"' || c == '\\') { ch('\\'); ch((char)c); }
+    else if (c < 0x20) {
+      raw("\\u00");
+      ch(hex[c >> 4]);
+      ch(hex[c & 0xf]);
+    }
+    else ch((char)c);
+  }
+  ch('"');
+}
+
+void JsonOut::comma() {
+  if (!first) ch(',');
+  first = false;
+}
+
+void JsonOut::key(const char* k) {
+  comma();
+  if (!k) return;
+  str(k);
+  ch(':');
+}
+
+// ---------------------------
+// CONTAINERS
+// ---------------------------
+void JsonOut::beginObject(const char* k) { key(k); ch('{'); first = true; }
+void JsonOut::endObject()                { ch('}'); first = false; }
+void JsonOut::beginArray(const char* k)  { key(k); ch('['); first = true; }
+void JsonOut::endArray()                 { ch(']'); first = false; }
+
+// ---------------------------
+// VALUES
+// ---------------------------
+void JsonOut::field(const char* k, const char* v) { key(k); str(v); }
+void JsonOut::field(const char* k, bool v)        { key(k); raw(v ? "true" : "false"); }
+
+// Formats into the tail of a 12-byte buffer, returns the first digit.
+static char* formatNumber(char* end, uint32_t v, bool negative) {
+  *--end = '\0';
+  do {
+    *--end = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+  if (negative) *--end = '-';
+  return end;
+}
+
+void JsonOut::field(const char* k, uint32_t v) {
+  char num[12];
+  key(k);
+  raw(formatNumber(num + sizeof(num), v, false));
+}
+
+void JsonOut::field(const char* k, int32_t v) {
+  char num[12];
+  uint32_t mag = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+  key(k);
+  raw(formatNumber(num + sizeof(num), mag, v < 0));
+}
+
+void JsonOut::value(uint32_t v) { field(nullptr, v); }
+void JsonOut::value(const char* s) { field(nullptr, s); }
+
+size_t JsonOut::finish() {
+  if (!ok) return 0;
+  out[len] = '\0';
+  return len;
+}
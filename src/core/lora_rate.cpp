@@ -0,0 +1,103 @@
+#include <math.h>
+#include "lora_rate.h"
+
+// ---------------------------
+// LADDER
+// ---------------------------
+const LoraRate loraRates[LORA_RATE_COUNT] = {
+  {  7, 500000,  -7.5f },
+  {  7, 250000,  -7.5f },
+  {  7, 125000,  -7.5f },
+  {  8, 125000, -10.0f },
+  {  9, 125000, -12.5f },
+  { 10, 125000, -15.0f },
+  { 11, 125000, -17.5f },
+  { 12, 125000, -20.0f },
+};
+
+static float bwPenaltyDb(uint32_t bwHz) {
+  return 10.0f * log10f((float)bwHz / 125000.0f);
+}
+
+float loraRequiredSnr(int i) {
+  return loraRates[i].floorDb + bwPenaltyDb(loraRates[i].bwHz);
+}
+
+float loraNormaliseSnr(float snrDb, int i) {
+  return snrDb + bwPenaltyDb(loraRates[i].bwHz);
+}
+
+uint32_t loraAirtimeUs(const LoraRate& r, uint8_t codingRate4, size_t payloadLen,
+                       uint8_t preamble) {
+  float tSym = (float)(1u << r.sf) / (float)r.bwHz * 1e6f;
+  int de = tSym > 16000.0f ? 1 : 0;   // low data rate optimisation
+  int cr = codingRate4 - 4;
+
+  float num = 8.0f * payloadLen - 4.0f * r.sf + 28 + 16;
+  float sym = ceilf(num / (4.0f * (r.sf - 2 * de))) * (cr + 4);
+  if (sym < 0) sym = 0;
+
+  float t = (preamble + 4.25f) * tSym + (8 + sym) * tSym;
+  return (uint32_t)t;
+}
+
+// ---------------------------
+// CONTROLLER
+// ---------------------------
+void LoraRateController::onReceived(uint16_t linkSeq, float snrDb, float rssiDbm, int rate,
+                                    uint32_t nowMs) {
+  (void)nowMs;
+  float s = loraNormaliseSnr(snrDb, rate);
+
+  if (total == 0) {
+    snrEwma = s;
+    rssiEwma = rssiDbm;
+  } else {
+    snrEwma += cfg.ewmaAlpha * (s - snrEwma);
+    rssiEwma += cfg.ewmaAlpha * (rssiDbm - rssiEwma);
+  }
+
+  // Frames missing since the last one we heard at this rate.
+  if (count > 0) {
+    uint16_t gap = (uint16_t)(linkSeq - lastSeq - 1);
+    if (gap > 64) gap = 64;   // peer restarted or long outage
+    for (uint16_t i = 0; i < gap; i++) lossEwma += cfg.lossAlpha * (1.0f - lossEwma);
+  }
+  lossEwma -= cfg.lossAlpha * lossEwma;
+
+  lastSeq = linkSeq;
+  count++;
+  total++;
+}
+
+void LoraRateController::onRateChanged(uint32_t nowMs) {
+  count = 0;
+  lossEwma = 0;
+  changedMs = nowMs;
+}
+
+int LoraRateController::decide(int current, uint32_t nowMs) const {
+  if (count < cfg.minSamples) return current;
+  uint32_t held = nowMs - changedMs;
+
+  int best = LORA_RATE_SLOWEST;
+  for (int i = 0; i < LORA_RATE_COUNT; i++) {
+    if (snrEwma >= loraRequiredSnr(i) + cfg.marginDb) {
+      best = i;
+      break;
+    }
+  }
+
+  if (held >= cfg.downHoldMs) {
+    if (lossEwma > cfg.targetLoss && current < LORA_RATE_SLOWEST) {
+      return best > current + 1 ? best : current + 1;
+    }
+    if (best > current) return best;
+  }
+
+  if (best < current && held >= cfg.upHoldMs && lossEwma <= cfg.targetLoss / 2 &&
+      snrEwma >= loraRequiredSnr(current - 1) + cfg.marginDb + cfg.upExtraDb) {
+    return current - 1;
+  }
+  return current;
+}
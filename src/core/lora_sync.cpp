@@ -0,0 +1,252 @@
+#include <math.h>
+#include <string.h>
+#include "lora_sync.h"
+
+static void put16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void put32(uint8_t* p, uint32_t v) {
+  for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+         ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// ---------------------------
+// FRAMES
+// ---------------------------
+size_t encodeLoraFrame(const LoraFrame& f, uint8_t* out) {
+  out[0] = LORA_FRAME_MAGIC;
+  out[1] = f.type;
+  put16(out + 2, f.planeId);
+  put16(out + 4, f.linkSeq);
+  out[6] = f.epoch;
+  out[7] = f.rate;
+  out[8] = (uint8_t)f.peerSnrQ4;
+  if (f.type != LORA_FRAME_HIT) return LORA_FRAME_HEADER;
+
+  put32(out + 9, f.hitSeq);
+  put32(out + 13, f.hitTimeMs);
+  return f.tagged ? loraFrameSetTag(out, f.tag) : LORA_FRAME_HIT_SIGNED;
+}
+
+size_t loraFrameSetTag(uint8_t* frame, const uint8_t tag[HIT_PACKET_TAG]) {
+  memcpy(frame + LORA_FRAME_HIT_SIGNED, tag, HIT_PACKET_TAG);
+  return LORA_FRAME_MAX;
+}
+
+bool decodeLoraFrame(const uint8_t* data, size_t len, LoraFrame& f) {
+  if (len < LORA_FRAME_HEADER || data[0] != LORA_FRAME_MAGIC) return false;
+  if (data[1] < LORA_FRAME_HIT || data[1] > LORA_FRAME_RATE_ACK) return false;
+  if (data[7] >= LORA_RATE_COUNT) return false;
+
+  f.type = (LoraFrameType)data[1];
+  f.planeId = get16(data + 2);
+  f.linkSeq = get16(data + 4);
+  f.epoch = data[6];
+  f.rate = data[7];
+  f.peerSnrQ4 = (int8_t)data[8];
+  f.hitSeq = 0;
+  f.hitTimeMs = 0;
+  f.tagged = false;
+
+  if (f.type == LORA_FRAME_HIT) {
+    if (len != LORA_FRAME_HIT_SIGNED && len != LORA_FRAME_MAX) return false;
+    f.hitSeq = get32(data + 9);
+    f.hitTimeMs = get32(data + 13);
+    f.tagged = len == LORA_FRAME_MAX;
+    if (f.tagged) memcpy(f.tag, data + LORA_FRAME_HIT_SIGNED, HIT_PACKET_TAG);
+  }
+  return true;
+}
+
+// ---------------------------
+// RATE SYNC
+// ---------------------------
+LoraRateSync::LoraRateSync(LoraRole role, uint16_t planeId, int initialRate,
+                           const LoraSyncConfig& c)
+  : role(role), planeId(planeId), cfg(c), cur(initialRate) {}
+
+uint32_t LoraRateSync::airtimeMs(int rate) const {
+  return loraAirtimeUs(loraRates[rate], cfg.codingRate4, LORA_FRAME_MAX) / 1000 + 1;
+}
+
+uint32_t LoraRateSync::listenMs() const {
+  return loraAirtimeUs(loraRates[cur], cfg.codingRate4, LORA_FRAME_HEADER) / 1000 + 1 +
+         cfg.listenSlackMs;
+}
+
+uint32_t LoraRateSync::beaconEvery() const {
+  uint32_t duty = 20 * airtimeMs(cur);
+  return duty > cfg.beaconMs ? duty : cfg.beaconMs;
+}
+
+void LoraRateSync::setRate(int r, uint32_t nowMs) {
+  if (r != cur) changes++;
+  cur = r;
+  stateMs = nowMs;
+}
+
+void LoraRateSync::stamp(LoraFrame& f) {
+  f.planeId = planeId;
+  f.linkSeq = txSeq++;
+  f.epoch = ep;
+  f.rate = (uint8_t)cur;
+  float q = roundf(peerSnr * 4);
+  f.peerSnrQ4 = (int8_t)(q > 127 ? 127 : q < -128 ? -128 : q);
+}
+
+void LoraRateSync::request(int newRate, uint32_t nowMs) {
+  if (role != LORA_ROLE_GROUND || st != LORA_SYNC_STABLE || newRate == cur) return;
+  if (newRate < 0 || newRate >= LORA_RATE_COUNT) return;
+
+  pendingRate = newRate;
+  retries = 0;
+  st = LORA_SYNC_REQUESTING;
+  stateMs = nowMs - cfg.retryMs - 3 * airtimeMs(cur);   // first REQ right away
+}
+
+void LoraRateSync::onFrame(const LoraFrame& f, uint32_t nowMs) {
+  heardMs = nowMs;
+  peerHeard = true;
+
+  switch (st) {
+    case LORA_SYNC_VERIFY:
+      // Heard at the new rate: both ends are here. The ground answers
+      // the plane's probe so the plane knows too.
+      st = LORA_SYNC_STABLE;
+      switches++;
+      if (role == LORA_ROLE_GROUND) beaconNow = true;
+      break;
+
+    case LORA_SYNC_REQUESTING:
+      if (f.type == LORA_FRAME_RATE_ACK && f.epoch == (uint8_t)(ep + 1) && f.rate == pendingRate) {
+        prev = cur;
+        prevEp = ep;
+        ep = f.epoch;
+        setRate(pendingRate, nowMs);
+        st = LORA_SYNC_VERIFY;
+      }
+      break;
+
+    case LORA_SYNC_STABLE:
+      if (role == LORA_ROLE_PLANE && f.type == LORA_FRAME_RATE_REQ && f.epoch != ep &&
+          f.rate < LORA_RATE_COUNT) {
+        pendingRate = f.rate;
+        prevEp = ep;
+        ep = f.epoch;
+        st = LORA_SYNC_ACKING;
+      } else if ((f.type == LORA_FRAME_BEACON || f.type == LORA_FRAME_HIT) &&
+                 (int8_t)(f.epoch - ep) > 0) {
+        ep = f.epoch;   // after a fallback the two ends may disagree; newest wins
+      }
+      break;
+
+    case LORA_SYNC_ACKING:
+      break;
+  }
+}
+
+bool LoraRateSync::poll(uint32_t nowMs, LoraFrame& out) {
+  if (!started) {
+    started = true;
+    heardMs = nowMs;
+    sentMs = nowMs - beaconEvery();
+  }
+
+  // Link lost: meet at the base rate. A link that never came up was not
+  // lost; both ends still share the starting rate.
+  uint32_t beacon = beaconEvery();
+  uint32_t lost = 4 * beacon > cfg.lostMs ? 4 * beacon : cfg.lostMs;
+  if (peerHeard && nowMs - heardMs > lost && cur != cfg.baseRate && st != LORA_SYNC_ACKING) {
+    setRate(cfg.baseRate, nowMs);
+    st = LORA_SYNC_STABLE;
+    fallbacks++;
+    heardMs = nowMs;
+    beaconNow = true;
+  }
+
+  uint32_t air = airtimeMs(cur);
+  out = LoraFrame();
+
+  switch (st) {
+    case LORA_SYNC_REQUESTING: {
+      uint32_t retry = 3 * air > cfg.retryMs ? 3 * air : cfg.retryMs;
+      if (nowMs - stateMs < retry) break;
+      // Aim for the plane's listen window unless it has gone quiet.
+      if (nowMs - heardMs > cfg.listenSlackMs && nowMs - stateMs < 3 * retry) break;
+      if (retries == cfg.maxRetries) {
+        st = LORA_SYNC_STABLE;
+        abandoned++;
+        break;
+      }
+      retries++;
+      stateMs = nowMs;
+      out.type = LORA_FRAME_RATE_REQ;
+      stamp(out);
+      out.epoch = (uint8_t)(ep + 1);
+      out.rate = (uint8_t)pendingRate;
+      return true;
+    }
+
+    case LORA_SYNC_ACKING:
+      out.type = LORA_FRAME_RATE_ACK;
+      stamp(out);
+      out.rate = (uint8_t)pendingRate;
+      ackOut = true;
+      return true;
+
+    case LORA_SYNC_VERIFY: {
+      uint32_t verify = 4 * air > cfg.verifyMs ? 4 * air : cfg.verifyMs;
+      if (nowMs - stateMs >= verify) {
+        setRate(prev, nowMs);
+        ep = prevEp;
+        st = LORA_SYNC_STABLE;
+        reverts++;
+        beaconNow = true;
+      } else if (role == LORA_ROLE_PLANE && nowMs - sentMs >= verify / 3 && hitClear(nowMs)) {
+        beaconNow = true;   // probe again; the ground only answers
+      }
+      break;
+    }
+
+    case LORA_SYNC_STABLE:
+      break;
+  }
+
+  // The ground answers in the plane's listen window, and only speaks
+  // unprompted once two plane beacons have gone missing.
+  bool window = role == LORA_ROLE_PLANE || nowMs - heardMs <= cfg.listenSlackMs ||
+                nowMs - heardMs >= 2 * beacon;
+  if (beaconNow || (nowMs - sentMs >= beacon && window)) {
+    out.type = LORA_FRAME_BEACON;
+    stamp(out);
+    return true;
+  }
+  return false;
+}
+
+bool LoraRateSync::hitClear(uint32_t nowMs) const {
+  return nowMs - sentMs >= listenMs();
+}
+
+void LoraRateSync::onSent(uint32_t nowMs) {
+  sentMs = nowMs;
+  beaconNow = false;
+
+  if (ackOut) {
+    ackOut = false;
+    prev = cur;
+    setRate(pendingRate, nowMs);
+    st = LORA_SYNC_VERIFY;
+    beaconNow = true;
+  }
+}
@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <string.h>
+#include "match_auth.h"
+
+static const char hexDigits[] = "0123456789abcdef";
+
+static void toHex(const uint8_t* p, size_t n, char* out) {
+  for (size_t i = 0; i < n; i++) {
+    out[2 * i]     = hexDigits[p[i] >> 4];
+    out[2 * i + 1] = hexDigits[p[i] & 15];
+  }
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+static bool fromHex(const char* s, size_t n, uint8_t* out) {
+  for (size_t i = 0; i < n; i++) {
+    int hi = hexValue(s[2 * i]), lo = hexValue(s[2 * i + 1]);
+    if (hi < 0 || lo < 0) return false;
+    out[i] = (uint8_t)(hi << 4 | lo);
+  }
+  return true;
+}
+
+static bool parseHex64(const char* s, size_t n, uint64_t& v) {
+  if (n != 16) return false;
+  uint8_t b[8];
+  if (!fromHex(s, 8, b)) return false;
+  v = 0;
+  for (int i = 0; i < 8; i++) v = v << 8 | b[i];
+  return true;
+}
+
+static bool parseU32(const char* s, size_t n, uint32_t& v) {
+  if (n == 0 || n > 10) return false;
+  uint64_t x = 0;
+  for (size_t i = 0; i < n; i++) {
+    if (s[i] < '0' || s[i] > '9') return false;
+    x = x * 10 + (uint64_t)(s[i] - '0');
+  }
+  if (x > 0xffffffffULL) return false;
+  v = (uint32_t)x;
+  return true;
+}
+
+void authHex64(uint64_t v, char out[16]) {
+  for (int i = 15; i >= 0; i--) {
+    out[i] = hexDigits[v & 15];
+    v >>= 4;
+  }
+}
+
+// "MATCH_START <nonce> <challenge>", what the phone's start tag covers.
+#define START_WORD     "MATCH_START"
+#define START_WORD_LEN (sizeof(START_WORD) - 1)
+#define START_NONCE    (START_WORD_LEN + 1)
+#define START_CHAL     (START_NONCE + 16 + 1)
+#define START_BODY_LEN (START_CHAL + 16)
+#define START_LINE_LEN (START_CHAL + AUTH_TAG_HEX)   // as sent: the tag replaces the challenge
+
+static void matchStartBody(uint64_t nonce, uint64_t challenge, char body[START_BODY_LEN]) {
+  memcpy(body, START_WORD, START_WORD_LEN);
+  body[START_WORD_LEN] = ' ';
+  authHex64(nonce, body + START_NONCE);
+  body[START_CHAL - 1] = ' ';
+  authHex64(challenge, body + START_CHAL);
+}
+
+// ---------------------------
+// LINES
+// ---------------------------
+size_t authSignLine(const HmacSha256& key, const char* body, size_t len, char* out, size_t cap) {
+  if (len + 1 + AUTH_TAG_HEX + 1 > cap) return 0;
+
+  uint8_t mac[SHA256_BYTES];
+  key.mac((const uint8_t*)body, len, mac);
+
+  if (out != body) memmove(out, body, len);
+  out[len] = ' ';
+  toHex(mac, AUTH_TAG_BYTES, out + len + 1);
+  out[len + 1 + AUTH_TAG_HEX] = '\0';
+  return len + 1 + AUTH_TAG_HEX;
+}
+
+bool authCheckTag(const HmacSha256& key, const uint8_t* data, size_t len,
+                  const uint8_t tag[HIT_PACKET_TAG]) {
+  uint8_t mac[SHA256_BYTES];
+  key.mac(data, len, mac);
+  return macEqual(mac, tag, HIT_PACKET_TAG);
+}
+
+AuthResult authCheckLine(const HmacSha256& key, const char* line, size_t len, size_t& bodyLen) {
+  if (len < AUTH_TAG_HEX + 2 || line[len - AUTH_TAG_HEX - 1] != ' ') return AUTH_UNSIGNED;
+
+  uint8_t tag[AUTH_TAG_BYTES];
+  if (!fromHex(line + len - AUTH_TAG_HEX, AUTH_TAG_BYTES, tag)) return AUTH_UNSIGNED;
+
+  bodyLen = len - AUTH_TAG_HEX - 1;
+  uint8_t mac[SHA256_BYTES];
+  key.mac((const uint8_t*)line, bodyLen, mac);
+  return macEqual(mac, tag, AUTH_TAG_BYTES) ? AUTH_OK : AUTH_BAD_TAG;
+}
+
+size_t authSignMatchStart(const HmacSha256& planeKey, uint64_t nonce, uint64_t challenge,
+                          char* out, size_t cap) {
+  if (START_LINE_LEN + 1 > cap) return 0;
+
+  char body[START_BODY_LEN];
+  matchStartBody(nonce, challenge, body);
+  uint8_t mac[SHA256_BYTES];
+  planeKey.mac((const uint8_t*)body, sizeof(body), mac);
+
+  memcpy(out, body, START_CHAL);
+  toHex(mac, AUTH_TAG_BYTES, out + START_CHAL);
+  out[START_LINE_LEN] = '\0';
+  return START_LINE_LEN;
+}
+
+void authPlaneKey(HmacSha256& out, const char* fleetSecret, uint16_t planeId) {
+  HmacSha256 fleet(out.backend());
+  fleet.setKey((const uint8_t*)fleetSecret, strlen(fleetSecret));
+
+  char label[16];
+  int n = snprintf(label, sizeof(label), "plane %u", (unsigned)planeId);
+  uint8_t key[SHA256_BYTES];
+  fleet.mac((const uint8_t*)label, (size_t)n, key);
+  out.setKey(key, sizeof(key));
+  memset(key, 0, sizeof(key));
+}
+
+void authMatchKey(HmacSha256& out, const HmacSha256& planeKey, uint64_t nonce, uint64_t challenge) {
+  char label[6 + 16 + 1 + 16];
+  memcpy(label, "match ", 6);
+  authHex64(nonce, label + 6);
+  label[22] = ' ';
+  authHex64(challenge, label + 23);
+
+  uint8_t key[SHA256_BYTES];
+  planeKey.mac((const uint8_t*)label, sizeof(label), key);
+  out.setKey(key, sizeof(key));
+  memset(key, 0, sizeof(key));
+}
+
+// ---------------------------
+// PLANE SIDE
+// ---------------------------
+MatchAuth::MatchAuth(HmacBackend b) : planeKey(b), match(b) {}
+
+void MatchAuth::begin(const char* fleetSecret, uint16_t planeId, uint64_t challenge) {
+  authPlaneKey(planeKey, fleetSecret, planeId);
+  chal = challenge;
+}
+
+AuthResult MatchAuth::verifyCommand(const char* data, size_t len, PhoneCommand& cmd,
+                                    uint64_t nextChallenge) {
+  cmd = CMD_UNKNOWN;
+  while (len > 0 && (data[len - 1] == ' ' || data[len - 1] == '\r' || data[len - 1] == '\n')) len--;
+
+  // Command word, then the arguments before the tag.
+  size_t word = 0;
+  while (word < len && data[word] != ' ') word++;
+  PhoneCommand parsed = parseCommand(data, word);
+
+  AuthResult r;
+  size_t bodyLen = 0;
+
+  if (parsed == CMD_MATCH_START) {
+    // "MATCH_START <nonce> <tag>", signed together with our challenge.
+    // Only the exact form: parseCommand() also accepts padded words.
+    uint64_t nonce;
+    uint8_t tag[AUTH_TAG_BYTES];
+    if (len == word) {
+      r = AUTH_UNSIGNED;
+    } else if (word != START_WORD_LEN || len != START_LINE_LEN ||
+               memcmp(data, START_WORD, START_WORD_LEN) != 0 ||
+               !parseHex64(data + START_NONCE, 16, nonce) || data[START_CHAL - 1] != ' ' ||
+               !fromHex(data + START_CHAL, AUTH_TAG_BYTES, tag)) {
+      r = AUTH_BAD_FORMAT;
+    } else {
+      char body[START_BODY_LEN];
+      matchStartBody(nonce, chal, body);
+
+      uint8_t mac[SHA256_BYTES];
+      planeKey.mac((const uint8_t*)body, sizeof(body), mac);
+      r = macEqual(mac, tag, AUTH_TAG_BYTES) ? AUTH_OK : AUTH_BAD_TAG;
+
+      if (r == AUTH_OK) {
+        authMatchKey(match, planeKey, nonce, chal);
+        keyed.store(true, std::memory_order_relaxed);
+        window.reset();
+        chal = nextChallenge;
+      }
+    }
+  } else {
+    // "<CMD> <seq> <tag>" under the match key.
+    const HmacSha256* key = matchKey();
+    r = key ? authCheckLine(*key, data, len, bodyLen) : AUTH_NO_MATCH;
+    if (!key && (len < AUTH_TAG_HEX + 2 || data[len - AUTH_TAG_HEX - 1] != ' ')) r = AUTH_UNSIGNED;
+
+    uint32_t seq = 0;
+    if (r == AUTH_OK && (bodyLen <= word + 1 || !parseU32(data + word + 1, bodyLen - word - 1, seq))) {
+      r = AUTH_BAD_FORMAT;
+    }
+    if (r == AUTH_OK && !window.accept(seq)) r = AUTH_REPLAY;
+  }
+
+  if (r != AUTH_OK) {
+    rejected[r]++;
+    return r;
+  }
+  accepted++;
+  cmd = parsed;
+  return AUTH_OK;
+}
+
+size_t MatchAuth::signHit(uint32_t seq, uint32_t timeMs, char* out, size_t cap) const {
+  const HmacSha256* key = matchKey();
+  if (!key) return 0;
+
+  int n = snprintf(out, cap, "HIT %lu %lu", (unsigned long)seq, (unsigned long)timeMs);
+  if (n < 0 || (size_t)n >= cap) return 0;
+  return authSignLine(*key, out, (size_t)n, out, cap);
+}
+
+bool MatchAuth::tagPacket(const uint8_t* pkt, uint8_t tag[HIT_PACKET_TAG]) const {
+  return tagFrame(pkt, HIT_PACKET_SIGNED, tag);
+}
+
+bool MatchAuth::tagFrame(const uint8_t* data, size_t len, uint8_t tag[HIT_PACKET_TAG]) const {
+  const HmacSha256* key = matchKey();
+  if (!key) return false;
+
+  uint8_t mac[SHA256_BYTES];
+  key->mac(data, len, mac);
+  memcpy(tag, mac, HIT_PACKET_TAG);
+  return true;
+}
@@ -0,0 +1,182 @@
+#include "match_record.h"
+#include "varint.h"
+
+static_assert((MATCH_RECORD_MAX & (MATCH_RECORD_MAX - 1)) == 0,
+              "MATCH_RECORD_MAX must be a power of two");
+static_assert(MATCH_DELTA_MAX <= 255, "MatchDelta::count is 8 bits");
+
+// ---------------------------
+// RECORD
+// ---------------------------
+void MatchRecord::append(uint8_t type, uint32_t timeMs, uint32_t value) {
+  version++;
+  MatchEntry& e = ring[(version - 1) & (MATCH_RECORD_MAX - 1)];
+  e.version = version;
+  e.timeMs = timeMs;
+  e.value = value;
+  e.type = type;
+  if (count < MATCH_RECORD_MAX) count++;
+}
+
+// A start during a match begins a new one; the phone restarted it.
+void MatchRecord::start(uint32_t nowMs) {
+  sum.match++;
+  sum.active = true;
+  sum.startMs = nowMs;
+  sum.hits = 0;
+  sum.lastHitMs = 0;
+  append(MATCH_ENTRY_START, nowMs, sum.match);
+}
+
+void MatchRecord::end(uint32_t nowMs) {
+  if (!sum.active) return;
+  sum.active = false;
+  append(MATCH_ENTRY_END, nowMs, sum.hits);
+}
+
+void MatchRecord::hit(uint32_t seq, uint32_t timeMs) {
+  sum.hits++;
+  sum.lastHitMs = timeMs;
+  append(MATCH_ENTRY_HIT, timeMs, seq);
+}
+
+void MatchRecord::delta(uint32_t since, MatchDelta& out) const {
+  uint32_t oldest = version - (uint32_t)count + 1;
+
+  out.reset = false;
+  if (since > version) {
+    since = 0;
+    out.reset = true;
+  }
+  if (since + 1 < oldest) {
+    since = oldest - 1;
+    out.reset = true;
+  }
+
+  uint32_t n = version - since;
+  if (n > MATCH_DELTA_MAX) n = MATCH_DELTA_MAX;
+
+  out.boot = boot;
+  out.from = since;
+  out.to = since + n;
+  out.head = version;
+  out.summary = sum;
+  out.count = (uint8_t)n;
+  for (uint32_t i = 0; i < n; i++) {
+    out.entries[i] = ring[(since + i) & (MATCH_RECORD_MAX - 1)];
+  }
+}
+
+// ---------------------------
+// BINARY DELTA
+// ---------------------------
+size_t encodeMatchDelta(const MatchDelta& d, uint8_t* out, size_t cap) {
+  if (cap < MATCH_DELTA_HEADER_MAX + (size_t)d.count * 11) return 0;
+
+  uint8_t* p = out;
+  *p++ = 'M';
+  *p++ = MATCH_DELTA_VERSION;
+  *p++ = (uint8_t)((d.reset ? MATCH_FLAG_RESET : 0) |
+                   (d.summary.active ? MATCH_FLAG_ACTIVE : 0));
+  *p++ = (uint8_t)d.boot;
+  *p++ = (uint8_t)(d.boot >> 8);
+  p += putVarint(p, d.from);
+  p += putVarint(p, d.to - d.from);
+  p += putVarint(p, d.head - d.to);
+  p += putVarint(p, d.summary.match);
+  p += putVarint(p, d.summary.hits);
+  p += putVarint(p, d.summary.startMs);
+  p += putVarint(p, d.summary.lastHitMs);
+
+  uint32_t prevTime = 0, prevSeq = 0;
+  for (uint8_t i = 0; i < d.count; i++) {
+    const MatchEntry& e = d.entries[i];
+    *p++ = e.type;
+    p += putSignedVarint(p, (int32_t)(e.timeMs - prevTime));
+    prevTime = e.timeMs;
+    if (e.type == MATCH_ENTRY_HIT) {
+      p += putVarint(p, e.value - prevSeq);
+      prevSeq = e.value;
+    } else {
+      p += putVarint(p, e.value);
+    }
+  }
+  return (size_t)(p - out);
+}
+
+bool decodeMatchDelta(const uint8_t* data, size_t len, MatchDelta& out) {
+  const uint8_t* p = data;
+  const uint8_t* end = data + len;
+  if (len < 5 || p[0] != 'M' || p[1] != MATCH_DELTA_VERSION) return false;
+
+  uint8_t flags = p[2];
+  out.boot = (uint16_t)(p[3] | (p[4] << 8));
+  p += 5;
+  out.reset = (flags & MATCH_FLAG_RESET) != 0;
+  out.summary.active = (flags & MATCH_FLAG_ACTIVE) != 0;
+
+  uint32_t n, ahead;
+  if (!getVarint(p, end, out.from) || !getVarint(p, end, n) ||
+      !getVarint(p, end, ahead) || !getVarint(p, end, out.summary.match) ||
+      !getVarint(p, end, out.summary.hits) || !getVarint(p, end, out.summary.startMs) ||
+      !getVarint(p, end, out.summary.lastHitMs)) {
+    return false;
+  }
+  if (n > MATCH_DELTA_MAX) return false;
+  out.to = out.from + n;
+  out.head = out.to + ahead;
+  out.count = (uint8_t)n;
+
+  uint32_t prevTime = 0, prevSeq = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    MatchEntry& e = out.entries[i];
+    if (p == end) return false;
+    e.type = *p++;
+    int32_t dt;
+    if (!getSignedVarint(p, end, dt) || !getVarint(p, end, e.value)) return false;
+    e.version = out.from + 1 + i;
+    e.timeMs = prevTime + (uint32_t)dt;
+    prevTime = e.timeMs;
+    if (e.type == MATCH_ENTRY_HIT) {
+      e.value += prevSeq;
+      prevSeq = e.value;
+    }
+  }
+  return p == end;
+}
+
+// ---------------------------
+// JSON
+// ---------------------------
+static const char* entryName(uint8_t type) {
+  switch (type) {
+    case MATCH_ENTRY_START: return "start";
+    case MATCH_ENTRY_HIT:   return "hit";
+    case MATCH_ENTRY_END:   return "end";
+    default:                return "?";
+  }
+}
+
+void writeMatchDeltaJson(JsonOut& j, const MatchDelta& d) {
+  j.field("boot", (uint32_t)d.boot);
+  j.field("from", d.from);
+  j.field("to", d.to);
+  j.field("head", d.head);
+  j.field("reset", d.reset);
+  j.field("match", d.summary.match);
+  j.field("active", d.summary.active);
+  j.field("start_ms", d.summary.startMs);
+  j.field("hits", d.summary.hits);
+  j.field("last_hit_ms", d.summary.lastHitMs);
+  j.beginArray("entries");
+  for (uint8_t i = 0; i < d.count; i++) {
+    const MatchEntry& e = d.entries[i];
+    j.beginArray();
+    j.value(e.version);
+    j.value(e.timeMs);
+    j.value(entryName(e.type));
+    j.value(e.value);
+    j.endArray();
+  }
+  j.endArray();
+}
@@ -0,0 +1,41 @@
+#include <string.h>
+#include "match_auth.h"
+#include "pools.h"
+
+static_assert(POOL_COMMAND_BYTES >= AUTH_LINE_MAX, "signed command does not fit a CommandBuffer");
+
+ObjectPool<HitEvent, POOL_HIT_EVENTS>       hitEventPool;
+ObjectPool<WsPayload, POOL_WS_PAYLOADS>     wsPayloadPool;
+ObjectPool<RadioPacket, POOL_RADIO_PACKETS> radioPacketPool;
+ObjectPool<CommandBuffer, POOL_COMMANDS>    commandPool;
+
+CommandBuffer* poolCommand(const char* data, size_t len) {
+  if (len > POOL_COMMAND_BYTES) return nullptr;
+  CommandBuffer* c = commandPool.acquire();
+  if (!c) return nullptr;
+  memcpy(c->data, data, len);
+  c->len = (uint16_t)len;
+  return c;
+}
+
+// ---------------------------
+// METRICS
+// ---------------------------
+template <typename T, size_t N>
+static void writePool(JsonOut& j, const char* name, const ObjectPool<T, N>& pool) {
+  j.beginObject(name);
+  j.field("size", (uint32_t)N);
+  j.field("in_use", pool.inUse());
+  j.field("high_water", pool.highWater());
+  j.field("exhausted", pool.exhausted());
+  j.endObject();
+}
+
+void poolsWriteJson(JsonOut& j) {
+  j.beginObject("pools");
+  writePool(j, "hit_events", hitEventPool);
+  writePool(j, "ws_payloads", wsPayloadPool);
+  writePool(j, "radio_packets", radioPacketPool);
+  writePool(j, "commands", commandPool);
+  j.endObject();
+}
@@ -0,0 +1,157 @@
+#include <string.h>
+#include "stall_profiler.h"
+
+static const char* const kindNames[] = { "run", "gap" };
+
+static uint8_t bucketOf(uint32_t us) {
+  uint8_t b = 0;
+  while (us && b < PROFILER_HIST_BUCKETS - 1) {
+    us >>= 1;
+    b++;
+  }
+  return b;
+}
+
+StallProfiler::StallProfiler(uint32_t runThresholdUs)
+  : runThresholdUs(runThresholdUs) {}
+
+int StallProfiler::addTask(const char* name, const char* const* stageNames, uint8_t stageCount,
+                           uint32_t gapThresholdUs) {
+  if (taskCount == PROFILER_MAX_TASKS) return -1;
+  TaskProfile& t = tasks[taskCount];
+  t.name = name;
+  t.stageNames = stageNames;
+  t.stageCount = stageCount < PROFILER_MAX_STAGES ? stageCount : PROFILER_MAX_STAGES;
+  t.gapThresholdUs = gapThresholdUs;
+  return taskCount++;
+}
+
+const char* StallProfiler::stageName(int task, uint8_t stage) const {
+  const TaskProfile& t = tasks[task];
+  return stage < t.stageCount ? t.stageNames[stage] : "?";
+}
+
+// ---------------------------
+// ITERATION BRACKETS
+// ---------------------------
+void StallProfiler::begin(int task, uint32_t nowUs) {
+  TaskProfile& t = tasks[task];
+  uint32_t gen = resetGen.load(std::memory_order_acquire);
+  if (gen != t.resetSeen) {
+    t.resetSeen = gen;
+    t.iterations = 0;
+    t.stalls = 0;
+    t.maxPeriodUs = 0;
+    t.maxRunUs = 0;
+    memset(t.periodHist, 0, sizeof(t.periodHist));
+    memset(t.runHist, 0, sizeof(t.runHist));
+  }
+  t.startUs = nowUs;
+  t.stageStartUs = nowUs;
+  t.stage = 0;
+  memset(t.stageUs, 0, sizeof(t.stageUs));
+}
+
+void StallProfiler::stage(int task, uint8_t stage, uint32_t nowUs) {
+  TaskProfile& t = tasks[task];
+  t.stageUs[t.stage] += nowUs - t.stageStartUs;
+  t.stageStartUs = nowUs;
+  t.stage = stage < t.stageCount ? stage : 0;
+}
+
+void StallProfiler::end(int task, uint32_t nowUs, uint32_t nowMs) {
+  TaskProfile& t = tasks[task];
+  t.stageUs[t.stage] += nowUs - t.stageStartUs;
+
+  uint32_t run = nowUs - t.startUs;
+  t.runHist[bucketOf(run)]++;
+  if (run > t.maxRunUs) t.maxRunUs = run;
+
+  if (t.iterations > 0) {
+    uint32_t period = t.startUs - t.lastStartUs;
+    t.periodHist[bucketOf(period)]++;
+    if (period > t.maxPeriodUs) t.maxPeriodUs = period;
+
+    uint32_t gap = t.startUs - t.lastEndUs;
+    if (t.gapThresholdUs && gap > t.gapThresholdUs) {
+      t.stalls++;
+      logStall({ nowMs, gap, (uint8_t)task, 0, STALL_GAP });
+    }
+  }
+  t.lastStartUs = t.startUs;
+  t.lastEndUs = nowUs;
+  t.iterations++;
+
+  if (run > runThresholdUs) {
+    uint8_t worst = 0;
+    for (uint8_t s = 1; s < t.stageCount; s++) {
+      if (t.stageUs[s] > t.stageUs[worst]) worst = s;
+    }
+    t.stalls++;
+    logStall({ nowMs, run, (uint8_t)task, worst, STALL_RUN });
+  }
+}
+
+// ---------------------------
+// STALL LOG
+// ---------------------------
+void StallProfiler::logStall(const StallRecord& r) {
+  while (logLock.test_and_set(std::memory_order_acquire)) {}
+  log[logNext % PROFILER_LOG_SIZE] = r;
+  logNext++;
+  logLock.clear(std::memory_order_release);
+}
+
+void StallProfiler::reset() {
+  resetGen.fetch_add(1, std::memory_order_release);
+
+  while (logLock.test_and_set(std::memory_order_acquire)) {}
+  logNext = 0;
+  logLock.clear(std::memory_order_release);
+}
+
+// ---------------------------
+// REPORT
+// ---------------------------
+void StallProfiler::writeJson(JsonOut& j) const {
+  j.beginArray("tasks");
+  for (int i = 0; i < taskCount; i++) {
+    const TaskProfile& t = tasks[i];
+    j.beginObject();
+    j.field("name", t.name);
+    j.field("iterations", t.iterations);
+    j.field("stalls", t.stalls);
+    j.field("gap_threshold_us", t.gapThresholdUs);
+    j.field("max_period_us", t.maxPeriodUs);
+    j.field("max_run_us", t.maxRunUs);
+    j.beginArray("period_hist_log2_us");
+    for (uint32_t n : t.periodHist) j.value(n);
+    j.endArray();
+    j.beginArray("run_hist_log2_us");
+    for (uint32_t n : t.runHist) j.value(n);
+    j.endArray();
+    j.endObject();
+  }
+  j.endArray();
+
+  StallRecord copy[PROFILER_LOG_SIZE];
+  while (logLock.test_and_set(std::memory_order_acquire)) {}
+  uint32_t total = logNext;
+  memcpy(copy, log, sizeof(copy));
+  logLock.clear(std::memory_order_release);
+
+  uint32_t kept = total < PROFILER_LOG_SIZE ? total : PROFILER_LOG_SIZE;
+  j.field("stalls_total", total);
+  j.beginArray("stalls");
+  for (uint32_t n = total - kept; n < total; n++) {
+    const StallRecord& r = copy[n % PROFILER_LOG_SIZE];
+    j.beginObject();
+    j.field("t_ms", r.timeMs);
+    j.field("task", taskName(r.task));
+    j.field("kind", kindNames[r.kind]);
+    j.field("stage", r.kind == STALL_RUN ? stageName(r.task, r.stage) : "-");
+    j.field("us", r.durationUs);
+    j.endObject();
+  }
+  j.endArray();
+}
@@ -0,0 +1,91 @@
+#include "telemetry_codec.h"
+#include "varint.h"
+
+static const char* const fieldNames[TELEM_FIELD_COUNT] = {
+  "rssi_dbm", "cpu0_pct", "cpu1_pct", "loop_period_us", "loop_jitter_us",
+  "loop_max_us", "cam_rx_queue", "udp_pending", "ws_clients", "heap_free",
+  "heap_largest", "heap_min", "cam_lines_ps", "hits", "hits_ignored",
+  "cam_unknown", "cam_overflows", "heap_failed",
+};
+
+const char* telemetryFieldName(int field) {
+  return (field >= 0 && field < TELEM_FIELD_COUNT) ? fieldNames[field] : "?";
+}
+
+// ---------------------------
+// ENCODER
+// ---------------------------
+size_t TelemetryEncoder::encode(const TelemetrySample& s, uint8_t* out, size_t cap) {
+  if (cap < TELEM_RECORD_MAX) return 0;
+  size_t n = 0;
+
+  if (!havePrev || sinceKey >= TELEM_KEYFRAME_EVERY) {
+    out[n++] = TELEM_REC_KEY;
+    n += putVarint(out + n, TELEM_FIELD_COUNT);
+    n += putVarint(out + n, s.timeMs);
+    for (int i = 0; i < TELEM_FIELD_COUNT; i++) n += putSignedVarint(out + n, s.values[i]);
+    sinceKey = 0;
+  } else {
+    uint32_t mask = 0;
+    for (int i = 0; i < TELEM_FIELD_COUNT; i++) {
+      if (s.values[i] != prev.values[i]) mask |= 1u << i;
+    }
+
+    out[n++] = TELEM_REC_DELTA;
+    n += putVarint(out + n, s.timeMs - prev.timeMs);
+    n += putVarint(out + n, mask);
+    for (int i = 0; i < TELEM_FIELD_COUNT; i++) {
+      if (mask & (1u << i)) {
+        n += putSignedVarint(out + n, (int32_t)((uint32_t)s.values[i] - (uint32_t)prev.values[i]));
+      }
+    }
+    sinceKey++;
+  }
+
+  prev = s;
+  havePrev = true;
+  return n;
+}
+
+// ---------------------------
+// DECODER
+// ---------------------------
+bool TelemetryDecoder::decode(const uint8_t* data, size_t len, TelemetrySample& out) {
+  const uint8_t* p = data;
+  const uint8_t* end = data + len;
+  if (p == end) return false;
+
+  uint8_t type = *p++;
+  TelemetrySample s = prev;
+
+  if (type == TELEM_REC_KEY) {
+    uint32_t count;
+    if (!getVarint(p, end, count) || !getVarint(p, end, s.timeMs)) return false;
+    for (uint32_t i = 0; i < count; i++) {
+      int32_t v;
+      if (!getSignedVarint(p, end, v)) return false;
+      if (i < TELEM_FIELD_COUNT) s.values[i] = v;
+    }
+    for (uint32_t i = count; i < TELEM_FIELD_COUNT; i++) s.values[i] = 0;
+  }
+  else if (type == TELEM_REC_DELTA) {
+    if (!havePrev) return false;
+    uint32_t dt, mask;
+    if (!getVarint(p, end, dt) || !getVarint(p, end, mask)) return false;
+    s.timeMs += dt;
+    for (int i = 0; i < 32; i++) {
+      if (!(mask & (1u << i))) continue;
+      int32_t d;
+      if (!getSignedVarint(p, end, d)) return false;
+      if (i < TELEM_FIELD_COUNT) s.values[i] = (int32_t)((uint32_t)s.values[i] + (uint32_t)d);
+    }
+  }
+  else {
+    return false;
+  }
+
+  prev = s;
+  havePrev = true;
+  out = s;
+  return true;
+}
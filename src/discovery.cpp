@@ -0,0 +1,30 @@
+#include <Arduino.h>
+#include <ESPmDNS.h>
+#include "discovery.h"
+#include "plane_identity_types.h"
+#include "version.h"
+
+static bool mdnsUp = false;
+
+bool discoveryBegin(const PlaneIdentity& plane) {
+  if (!MDNS.begin(plane.hostname)) return false;
+
+  char id[6];
+  snprintf(id, sizeof(id), "%u", plane.id);
+
+  MDNS.setInstanceName(plane.name);
+  MDNS.addService(MDNS_SERVICE, MDNS_PROTO, 80);
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "id", id);
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "name", plane.name);
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "model", plane.model);
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "fw", FIRMWARE_VERSION);
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "ws", "/ws");
+
+  mdnsUp = true;
+  return true;
+}
+
+void discoverySetStatus(const char* status) {
+  if (!mdnsUp) return;
+  MDNS.addServiceTxt(MDNS_SERVICE, MDNS_PROTO, "status", status);
+}
@@ -2,40 +2,150 @@
 #include <WiFi.h>
 #include <AsyncTCP.h>
 #include <ESPAsyncWebServer.h>
-#include <ESPmDNS.h>
-#include "hiddengems.h"   // ssid, password, PLANE_NAME
-
-// ---------------------------
-// CAMERA UART PINS (working)
-// ---------------------------
-#define CAM_RX 16   // ESP32 receives from H7 TX
-#define CAM_TX 17   // ESP32 sends to H7 RX (not required but kept)
+#include "hiddengems.h"   // ssid, password
+#include "plane_identity.h"
+#include "discovery.h"
+#include "udp_hits.h"
+#include "hit_pipeline.h"
+#include "commands.h"
+#include "heap_track.h"
+#include "telemetry.h"
+#include "stall_watch.h"
+#include "camera_capture.h"
+#include "camera_channel.h"
+#include "camera_inputs.h"
+#include "lora_radio.h"
+#include "phone_auth.h"
+#include "match_sync.h"
+#include "match_record.h"
+#include "pools.h"
+#include "event_bus.h"
+#include "spsc_queue.h"
 
 AsyncWebServer server(80);
 AsyncWebSocket ws("/ws");
 
-bool matchActive = true;   // TEMP: always allow hits so we can test
+HitPipeline pipeline;      // camera bytes -> match gate -> merge -> broadcastHit
+
+// Commands arrive on the AsyncTCP task and run in loop(); hit frames wait
+// in the outbox while a WebSocket client queue is full.
+static SpscQueue<CommandBuffer*, POOL_COMMANDS> commandQueue;
+static SpscQueue<WsPayload*, POOL_WS_PAYLOADS> wsOutbox;
+
+static_assert(POOL_WS_PAYLOAD_BYTES >= AUTH_HIT_FRAME_MAX, "hit frame does not fit a WsPayload");
+
+#define METRICS_JSON_MAX 3584
+
+const char* planeStatus() {
+  return pipeline.isMatchActive() ? "in_match" : "ready";
+}
 
 // ---------------------------
 // SEND HIT TO THE PHONE
 // ---------------------------
-void broadcastHit() {
-  ws.textAll("HIT");
-  Serial.println("🔥 HIT sent to phone");
+// With no phone connected queued frames are dropped.
+void flushWsOutbox() {
+  WsPayload* frame;
+  while (wsOutbox.size() > 0) {
+    bool phones = ws.count() > 0;
+    if (phones && !ws.availableForWriteAll()) return;
+    wsOutbox.pop(frame);
+    if (phones) ws.textAll(frame->data, frame->len);
+    wsPayloadPool.release(frame);
+  }
+}
+
+void sendHitUdp(const HitEvent& hit) {
+  udpHitsSend(hit.seq, hit.timeMs);
+}
+
+void sendHitLora(const HitEvent& hit) {
+  loraRadioSendHit(hit.seq, hit.timeMs);
 }
 
+void sendHitWs(const HitEvent& hit) {
+  WsPayload* frame = wsPayloadPool.acquire();
+  if (frame) {
+    frame->len = (uint16_t)phoneAuthHitFrame(hit.seq, hit.timeMs, frame->data, sizeof(frame->data));
+    wsOutbox.push(frame);
+  }
+  flushWsOutbox();
+}
+
+void logHit(const HitEvent& hit) {
+  Serial.print("🔥 HIT ");
+  Serial.print(hit.seq);
+  Serial.println(" sent to phone");
+}
+
+// Serial can block for a line's worth of bytes; print after the sends.
+typedef AsyncSubscriber<HitEvent, logHit, 8> HitLog;
+typedef EventBus<HitEvent, matchSyncOnHit, sendHitUdp, sendHitLora, sendHitWs,
+                 HitLog::deliver> HitBus;
+
+void broadcastHit(const HitEvent& hit) {
+  stallLoopStage(LOOP_STAGE_BROADCAST);
+  HitBus::publish(hit);
+  stallLoopStage(LOOP_STAGE_CAMERA);
+}
+
+// ---------------------------
+// MATCH STATE
+// ---------------------------
+// Subscribers run in order; the pipeline goes first so planeStatus() is
+// already current for the rest.
+void applyMatchPipeline(const MatchEvent& e) {
+  pipeline.setMatchActive(e.active);
+}
+
+void applyMatchCamera(const MatchEvent& e) {
+  cameraChannelSetMatch(e.active);
+}
+
+void applyMatchStall(const MatchEvent& e) {
+  if (e.active) stallWatchReset();
+}
+
+void applyMatchDiscovery(const MatchEvent&) {
+  discoverySetStatus(planeStatus());
+}
+
+typedef EventBus<MatchEvent, applyMatchPipeline, matchSyncOnMatch, applyMatchCamera,
+                 applyMatchStall, applyMatchDiscovery> MatchBus;
+
 // ---------------------------
 // HANDLE PHONE COMMANDS
 // ---------------------------
-void handleIncomingMessage(const String& msg) {
+void handleIncomingMessage(uint32_t client, const char* data, size_t len) {
   Serial.print("📩 From Phone: ");
-  Serial.println(msg);
+  Serial.write((const uint8_t*)data, len);
+  Serial.println();
 
-  if (msg == "MATCH_START") {
-    matchActive = true;
+  uint32_t since;
+  if (parseSyncCommand(data, len, since)) {
+    static uint8_t delta[MATCH_DELTA_BYTES_MAX];
+    size_t n = matchSyncEncode(since, delta, sizeof(delta));
+    if (n) ws.binary(client, delta, n);
+    return;
   }
-  else if (msg == "MATCH_END") {
-    matchActive = false;
+
+  switch (phoneAuthCommand(data, len)) {
+    case CMD_MATCH_START:
+      MatchBus::publish(MatchEvent{ true });
+      break;
+    case CMD_MATCH_END:
+      MatchBus::publish(MatchEvent{ false });
+      break;
+    default:
+      break;
+  }
+}
+
+void pollCommands() {
+  CommandBuffer* cmd;
+  while (commandQueue.pop(cmd)) {
+    handleIncomingMessage(cmd->client, cmd->data, cmd->len);
+    commandPool.release(cmd);
   }
 }
 
@@ -44,46 +154,79 @@ void handleIncomingMessage(const String& msg) {
 // ---------------------------
 void setup() {
   Serial.begin(115200);
-  Serial2.begin(115200, SERIAL_8N1, CAM_RX, CAM_TX);
 
   Serial.println("\n📡 Aeroduel Plane Booting...");
   Serial.print("Plane Name: ");
-  Serial.println(PLANE_NAME);
+  Serial.println(kPlane.name);
 
   // --- WiFi ---
   WiFi.mode(WIFI_STA);
   WiFi.begin(ssid, password);
 
   Serial.print("Connecting to WiFi");
+  uint32_t wifiStart = millis();
   while (WiFi.status() != WL_CONNECTED) {
     Serial.print(".");
     delay(400);
   }
+  uint32_t wifiWaitMs = millis() - wifiStart;
 
   Serial.println("\n✅ Connected!");
   Serial.print("IP: ");
   Serial.println(WiFi.localIP());
 
-  // --- mDNS name: foxtrotwhite.local ---
-  String mdnsName = PLANE_NAME;
-  mdnsName.toLowerCase();
-  mdnsName.replace(" ", "");
-
-  if (MDNS.begin(mdnsName.c_str())) {
+  // --- mDNS name from the fleet manifest, e.g. foxtrotwhite.local ---
+  if (discoveryBegin(kPlane)) {
+    discoverySetStatus(planeStatus());
     Serial.print("🌐 mDNS: http://");
-    Serial.print(mdnsName);
-    Serial.println(".local");
+    Serial.print(kPlane.hostname);
+    Serial.println(".local (_aeroduel._tcp)");
   } else {
     Serial.println("❌ mDNS failed to start");
   }
 
+  // --- UDP hit channel ---
+  udpHitsBegin(kPlane.id);
+  phoneAuthBegin(server, kPlane.id);
+  matchSyncBegin(server);
+
+  // --- LoRa backup hit channel, adaptive rate ---
+  loraRadioBegin(kPlane.lora, kPlane.id);
+
   // --- /id endpoint for the phone ---
   server.on("/id", HTTP_GET, [](AsyncWebServerRequest *request) {
-    String json = "{";
-    json += "\"name\":\"" + String(PLANE_NAME) + "\",";
-    json += "\"model\":\"F22\",";
-    json += "\"status\":\"ready\"";
-    json += "}";
+    StallNetScope scope(NET_STAGE_HTTP);
+    request->send(200, "application/json",
+                  pipeline.isMatchActive() ? kPlane.idJsonInMatch : kPlane.idJsonReady);
+  });
+
+  // --- /metrics: counters + heap health ---
+  server.on("/metrics", HTTP_GET, [](AsyncWebServerRequest *request) {
+    StallNetScope scope(NET_STAGE_HTTP);
+    static char json[METRICS_JSON_MAX];   // only async_tcp runs handlers
+    JsonOut j(json, sizeof(json));
+    j.beginObject();
+    j.field("uptime_ms", (uint32_t)millis());
+    j.field("hits", pipeline.lastSeq());
+    j.field("hits_ignored", pipeline.hitsIgnored);
+    j.field("cam_lines", pipeline.camLines);
+    j.field("cam_unknown", pipeline.unknownLines);
+    j.field("cam_overflows", pipeline.overflows());
+    j.field("cam_heartbeats", pipeline.heartbeats);
+    j.field("cam_bad_heartbeats", pipeline.badHeartbeats);
+    j.field("cam_late", pipeline.merger().late);
+    cameraInputsWriteJson(j, pipeline);
+    cameraChannelWriteJson(j);
+    loraRadioWriteJson(j);
+    phoneAuthWriteJson(j);
+    matchSyncWriteJson(j);
+    poolsWriteJson(j);
+    heapTrackWriteJson(j);
+    j.endObject();
+    if (!j.finish()) {
+      request->send(500, "text/plain", "metrics too large");
+      return;
+    }
     request->send(200, "application/json", json);
   });
 
@@ -102,40 +245,54 @@ void setup() {
       Serial.println("📴 Phone Disconnected");
     }
     else if (type == WS_EVT_DATA) {
-      String msg;
-      for (int i = 0; i < len; i++) msg += (char)data[i];
-      handleIncomingMessage(msg);
+      StallNetScope scope(NET_STAGE_WS);
+      CommandBuffer* cmd = poolCommand((const char*)data, len);
+      if (!cmd) {
+        Serial.println("⛔ Command dropped, no buffer");
+        return;
+      }
+      cmd->client = client->id();
+      commandQueue.push(cmd);
     }
   });
 
   server.addHandler(&ws);
+  telemetryBegin(server, pipeline);
+  stallWatchBegin(server, wifiWaitMs);
+  captureBegin(server, kPlane.id);
+  cameraChannelBegin(server, pipeline.isMatchActive());
   server.begin();
   Serial.println("🌐 Web Server + WS Ready");
+
+  pipeline.setSink(broadcastHit);
+  pipeline.setHeartbeatSink(cameraChannelHeartbeat);
+  cameraInputsBegin();
+  heapTrackSetupDone();
 }
 
 // ---------------------------
 // MAIN LOOP — CAMERA HIT CHECK
 // ---------------------------
 void loop() {
-  if (Serial2.available()) {
-    String msg = Serial2.readStringUntil('\n');
-    msg.trim();
-
-    if (msg.length() > 0) {
-      Serial.print("CAM SAYS: ");
-      Serial.println(msg);
-
-      if (msg == "HIT") {
-        Serial.println("💥 HIT FROM CAMERA!");
-
-        if (matchActive) {
-          broadcastHit();
-        } else {
-          Serial.println("❌ HIT IGNORED (match inactive)");
-        }
-      }
-    }
-  }
+  stallLoopBegin();
+  telemetryLoopTick();
+  pollCommands();
+
+  stallLoopStage(LOOP_STAGE_CAMERA);
+  capturePoll(pipeline.isMatchActive(), micros());
+  cameraInputsPoll(pipeline);
+  cameraChannelPoll(millis());
+  loraRadioPoll(millis());
+
+  stallLoopStage(LOOP_STAGE_BROADCAST);
+  flushWsOutbox();
+
+  stallLoopStage(LOOP_STAGE_LOG);
+  HitLog::drain();
+
+  stallLoopStage(LOOP_STAGE_TELEMETRY);
+  telemetryPoll();
+  stallLoopEnd();
 
   delay(20);
 }
@@ -0,0 +1,184 @@
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "heap_track.h"
+
+static const char* const subsystemNames[HEAP_SYS_COUNT] = {
+  "loop", "network", "timer", "wifi", "other",
+};
+
+#if HEAP_TRACK
+
+static HeapSubsystemStats stats[HEAP_SYS_COUNT];
+static uint32_t allocsAtSetup[HEAP_SYS_COUNT];
+static bool setupDone = false;
+static uint32_t liveBytes = 0;
+
+// ---------------------------
+// TASK -> SUBSYSTEM CACHE
+// ---------------------------
+#define TASK_CACHE_SIZE 16
+
+// An entry is published by storing task last (release); readers acquire
+// it and only look at sys / name when it is their own handle. A deleted
+// task's TCB can come back as a new task, so a hit also checks the name,
+// which is all the classification depends on. When the cache is full,
+// tasks are classified on every call.
+struct TaskEntry {
+  TaskHandle_t  task;
+  HeapSubsystem sys;
+  char          name[configMAX_TASK_NAME_LEN];
+};
+
+static TaskEntry taskCache[TASK_CACHE_SIZE];
+static portMUX_TYPE cacheMux = portMUX_INITIALIZER_UNLOCKED;
+
+static HeapSubsystem classifyByName(const char* name) {
+  if (!strcmp(name, "loopTask")) return HEAP_SYS_LOOP;
+  if (!strcmp(name, "async_tcp")) return HEAP_SYS_NETWORK;
+  if (!strcmp(name, "esp_timer")) return HEAP_SYS_TIMER;
+  if (!strcmp(name, "tiT") || !strcmp(name, "wifi") ||
+      !strcmp(name, "sys_evt") || !strcmp(name, "arduino_events")) {
+    return HEAP_SYS_WIFI;
+  }
+  return HEAP_SYS_OTHER;
+}
+
+static HeapSubsystem currentSubsystem() {
+  if (xPortInIsrContext()) return HEAP_SYS_OTHER;
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  if (!task) return HEAP_SYS_OTHER;
+  const char* name = pcTaskGetName(task);
+
+  for (TaskEntry& e : taskCache) {
+    if (__atomic_load_n(&e.task, __ATOMIC_ACQUIRE) != task) continue;
+    if (!strncmp(e.name, name, sizeof(e.name))) return e.sys;
+
+    // Reused TCB: only this task ever reads this entry, so rewrite it in place.
+    HeapSubsystem sys = classifyByName(name);
+    portENTER_CRITICAL(&cacheMux);
+    e.sys = sys;
+    strncpy(e.name, name, sizeof(e.name));
+    portEXIT_CRITICAL(&cacheMux);
+    return sys;
+  }
+
+  HeapSubsystem sys = classifyByName(name);
+  portENTER_CRITICAL(&cacheMux);
+  for (TaskEntry& e : taskCache) {
+    if (e.task) continue;
+    e.sys = sys;
+    strncpy(e.name, name, sizeof(e.name));
+    __atomic_store_n(&e.task, task, __ATOMIC_RELEASE);
+    break;
+  }
+  portEXIT_CRITICAL(&cacheMux);
+  return sys;
+}
+
+// Block sizes as the heap reports them (rounded up), the same measure
+// free() subtracts, so live_bytes cannot drift.
+static void countAlloc(void* p) {
+  HeapSubsystemStats& s = stats[currentSubsystem()];
+  if (!p) {
+    __atomic_fetch_add(&s.failed, 1, __ATOMIC_RELAXED);
+    return;
+  }
+  size_t size = heap_caps_get_allocated_size(p);
+  __atomic_fetch_add(&s.allocs, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&s.bytes, (uint32_t)size, __ATOMIC_RELAXED);
+  __atomic_fetch_add(&liveBytes, (uint32_t)size, __ATOMIC_RELAXED);
+}
+
+static void countFree(size_t size) {
+  HeapSubsystemStats& s = stats[currentSubsystem()];
+  __atomic_fetch_add(&s.frees, 1, __ATOMIC_RELAXED);
+  __atomic_fetch_sub(&liveBytes, (uint32_t)size, __ATOMIC_RELAXED);
+}
+
+// ---------------------------
+// LINKER WRAPPERS
+// ---------------------------
+extern "C" {
+void* __real_malloc(size_t size);
+void  __real_free(void* p);
+void* __real_calloc(size_t n, size_t size);
+void* __real_realloc(void* p, size_t size);
+
+void* __wrap_malloc(size_t size) {
+  void* p = __real_malloc(size);
+  countAlloc(p);
+  return p;
+}
+
+void __wrap_free(void* p) {
+  if (p) countFree(heap_caps_get_allocated_size(p));
+  __real_free(p);
+}
+
+void* __wrap_calloc(size_t n, size_t size) {
+  void* p = __real_calloc(n, size);
+  countAlloc(p);
+  return p;
+}
+
+void* __wrap_realloc(void* p, size_t size) {
+  size_t old = p ? heap_caps_get_allocated_size(p) : 0;
+  void* q = __real_realloc(p, size);
+  if (p && (q || size == 0)) countFree(old);
+  if (size) countAlloc(q);
+  return q;
+}
+}
+
+void heapTrackSetupDone() {
+  for (int i = 0; i < HEAP_SYS_COUNT; i++) allocsAtSetup[i] = stats[i].allocs;
+  setupDone = true;
+}
+
+HeapSubsystemStats heapTrackStats(HeapSubsystem sys) {
+  return stats[sys];
+}
+
+#else
+
+void heapTrackSetupDone() {}
+
+HeapSubsystemStats heapTrackStats(HeapSubsystem) {
+  return HeapSubsystemStats();
+}
+
+#endif
+
+// ---------------------------
+// METRICS
+// ---------------------------
+void heapTrackWriteJson(JsonOut& j) {
+  uint32_t freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  uint32_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+
+  j.beginObject("heap");
+  j.field("free", freeBytes);
+  j.field("min_free", (uint32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+  j.field("largest_block", largest);
+  j.field("frag_pct", freeBytes ? (uint32_t)(100 - (uint64_t)largest * 100 / freeBytes) : 0u);
+
+#if HEAP_TRACK
+  j.field("live_bytes", liveBytes);
+  j.beginObject("subsystems");
+  for (int i = 0; i < HEAP_SYS_COUNT; i++) {
+    const HeapSubsystemStats& s = stats[i];
+    j.beginObject(subsystemNames[i]);
+    j.field("allocs", s.allocs);
+    j.field("frees", s.frees);
+    j.field("bytes", s.bytes);
+    j.field("failed", s.failed);
+    if (setupDone) j.field("allocs_since_setup", s.allocs - allocsAtSetup[i]);
+    j.endObject();
+  }
+  j.endObject();
+#else
+  (void)subsystemNames;
+#endif
+
+  j.endObject();
+}
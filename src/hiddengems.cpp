@@ -2,4 +2,6 @@
 
 const char* ssid = "Forgot The Password";
 const char* password = "I dont know";
-const char* PLANE_NAME = "Foxtrot White";
+
+// Fleet secret for signed commands and hits (phone_auth.h); the phone app needs the same one.
+const char* authSecret = "Change me before the first match";
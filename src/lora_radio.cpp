@@ -0,0 +1,212 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <RadioLib.h>
+#include "lora_radio.h"
+#include "lora_sync.h"
+#include "phone_auth.h"
+#include "pools.h"
+#include "spsc_queue.h"
+
+static SX1262 radio = new Module(LORA_PIN_NSS, LORA_PIN_DIO1, LORA_PIN_RST, LORA_PIN_BUSY);
+
+static bool ready = false;
+static LoraRateSync* sync = nullptr;
+static uint8_t codingRate4 = 5;
+static int appliedRate = -1;
+
+// DIO1 signals both TX done and RX done; txBusy tells them apart.
+static volatile bool dio1 = false;
+static bool txBusy = false;
+
+static SpscQueue<HitEvent*, POOL_HIT_EVENTS> hitQueue;
+
+// Downlink SNR, reported back to the ground in every frame.
+static float rxSnr = 0;
+static bool rxSnrSet = false;
+
+static uint32_t framesSent = 0;
+static uint32_t framesHeard = 0;
+static uint32_t badFrames = 0;
+static uint32_t hitsSent = 0;
+static uint32_t hitsDropped = 0;
+static uint32_t txErrors = 0;
+static uint32_t hitsSigned = 0;
+
+static void IRAM_ATTR onDio1() {
+  dio1 = true;
+}
+
+// Ladder entry matching the manifest, else the slowest.
+static int manifestRate(const LoraParams& p) {
+  for (int i = 0; i < LORA_RATE_COUNT; i++) {
+    if (loraRates[i].sf == p.spreadingFactor && loraRates[i].bwHz == p.bandwidthHz) return i;
+  }
+  return LORA_RATE_SLOWEST;
+}
+
+// Back to receive at the new rate (applying it leaves the radio in standby).
+static void applyRate(int rate) {
+  radio.standby();
+  radio.setSpreadingFactor(loraRates[rate].sf);
+  radio.setBandwidth(loraRates[rate].bwHz / 1000.0f);
+  appliedRate = rate;
+  if (!txBusy) radio.startReceive();
+
+  Serial.print("📶 LoRa rate SF");
+  Serial.print(loraRates[rate].sf);
+  Serial.print(" / ");
+  Serial.print(loraRates[rate].bwHz / 1000);
+  Serial.println(" kHz");
+}
+
+static void transmit(const LoraFrame& f) {
+  uint8_t buf[LORA_FRAME_MAX];
+  size_t n = encodeLoraFrame(f, buf);
+
+  // Hits are signed like the UDP packet; the tag covers the stamped header.
+  uint8_t tag[HIT_PACKET_TAG];
+  if (f.type == LORA_FRAME_HIT && phoneAuthFrameTag(buf, LORA_FRAME_HIT_SIGNED, tag)) {
+    n = loraFrameSetTag(buf, tag);
+    hitsSigned++;
+  }
+
+  if (radio.startTransmit(buf, n) != RADIOLIB_ERR_NONE) {
+    txErrors++;
+    radio.startReceive();
+    return;
+  }
+  txBusy = true;
+  framesSent++;
+}
+
+static void receive(uint32_t nowMs) {
+  uint8_t buf[LORA_FRAME_MAX];
+  size_t n = radio.getPacketLength();
+  bool ok = n <= sizeof(buf) && radio.readData(buf, n) == RADIOLIB_ERR_NONE;
+  float snr = radio.getSNR();
+  radio.startReceive();
+
+  LoraFrame f;
+  if (!ok || !decodeLoraFrame(buf, n, f) || f.rate != appliedRate) {
+    badFrames++;
+    return;
+  }
+  framesHeard++;
+
+  rxSnr = rxSnrSet ? rxSnr + 0.2f * (snr - rxSnr) : snr;
+  rxSnrSet = true;
+  sync->setPeerSnr(loraNormaliseSnr(rxSnr, appliedRate));
+  sync->onFrame(f, nowMs);
+}
+
+// ---------------------------
+// PUBLIC API
+// ---------------------------
+void loraRadioBegin(const LoraParams& params, uint16_t planeId) {
+#if LORA_ENABLED
+  SPI.begin(LORA_PIN_SCK, LORA_PIN_MISO, LORA_PIN_MOSI, LORA_PIN_NSS);
+
+  int start = manifestRate(params);
+  int16_t err = radio.begin(params.freqHz / 1e6f, loraRates[start].bwHz / 1000.0f,
+                            loraRates[start].sf, params.codingRate4, params.syncWord,
+                            params.txPowerDbm, LORA_PREAMBLE, LORA_TCXO_VOLTAGE);
+  if (err != RADIOLIB_ERR_NONE) {
+    Serial.print("❌ LoRa radio not found, error ");
+    Serial.println(err);
+    return;
+  }
+  radio.setCRC(2);
+  radio.setDio1Action(onDio1);
+
+  LoraSyncConfig c;
+  c.codingRate4 = params.codingRate4;
+  codingRate4 = params.codingRate4;
+
+  static LoraRateSync planeSync(LORA_ROLE_PLANE, planeId, start, c);
+  sync = &planeSync;
+  ready = true;
+
+  Serial.print("📡 LoRa hits at ");
+  Serial.print(params.freqHz / 1000);
+  Serial.println(" kHz, adaptive rate");
+  applyRate(sync->rate());
+#else
+  (void)params;
+  (void)planeId;
+#endif
+}
+
+void loraRadioSendHit(uint32_t seq, uint32_t timeMs) {
+  if (!ready) return;
+
+  HitEvent* hit = hitEventPool.acquire();
+  if (!hit) {
+    hitsDropped++;
+    return;
+  }
+  hit->seq = seq;
+  hit->timeMs = timeMs;
+  hitQueue.push(hit);
+}
+
+void loraRadioPoll(uint32_t nowMs) {
+  if (!ready) return;
+
+  if (dio1) {
+    dio1 = false;
+    if (txBusy) {
+      radio.finishTransmit();
+      txBusy = false;
+      sync->onSent(nowMs);
+      radio.startReceive();
+    } else {
+      receive(nowMs);
+    }
+  }
+  if (txBusy) return;
+
+  if (sync->rate() != appliedRate) applyRate(sync->rate());
+
+  LoraFrame f;
+  if (sync->poll(nowMs, f)) {
+    if (sync->rate() != appliedRate) applyRate(sync->rate());
+    transmit(f);
+    return;
+  }
+
+  HitEvent* hit;
+  if (hitQueue.size() > 0 && sync->hitClear(nowMs) && hitQueue.pop(hit)) {
+    f = LoraFrame();
+    f.type = LORA_FRAME_HIT;
+    sync->stamp(f);
+    f.hitSeq = hit->seq;
+    f.hitTimeMs = hit->timeMs;
+    hitEventPool.release(hit);
+    transmit(f);
+    hitsSent++;
+  }
+}
+
+void loraRadioWriteJson(JsonOut& j) {
+  j.beginObject("lora");
+  j.field("enabled", ready);
+  if (ready) {
+    j.field("sf", (uint32_t)loraRates[appliedRate].sf);
+    j.field("bw_hz", loraRates[appliedRate].bwHz);
+    j.field("airtime_us", loraAirtimeUs(loraRates[appliedRate], codingRate4, LORA_FRAME_MAX));
+    j.field("epoch", (uint32_t)sync->epoch());
+    j.field("rx_snr_x10", (int32_t)(rxSnr * 10));
+    j.field("frames_sent", framesSent);
+    j.field("frames_heard", framesHeard);
+    j.field("bad_frames", badFrames);
+    j.field("tx_errors", txErrors);
+    j.field("hits_sent", hitsSent);
+    j.field("hits_signed", hitsSigned);
+    j.field("hits_dropped", hitsDropped);
+    j.field("hits_queued", (uint32_t)hitQueue.size());
+    j.field("rate_switches", sync->switches);
+    j.field("rate_reverts", sync->reverts);
+    j.field("fallbacks", sync->fallbacks);
+  }
+  j.endObject();
+}
@@ -0,0 +1,83 @@
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_random.h>
+#include "match_sync.h"
+#include "match_record.h"
+
+#define MATCH_JSON_MAX 2048
+
+static MatchRecord record;
+static portMUX_TYPE recordMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t httpRequests = 0;
+static uint32_t wsRequests = 0;
+static uint32_t resets = 0;
+
+static void takeDelta(uint32_t since, MatchDelta& d) {
+  portENTER_CRITICAL(&recordMux);
+  record.delta(since, d);
+  portEXIT_CRITICAL(&recordMux);
+  if (d.reset) resets++;
+}
+
+void matchSyncBegin(AsyncWebServer& server) {
+  record.setBoot((uint16_t)esp_random());
+
+  server.on("/match", HTTP_GET, [](AsyncWebServerRequest* request) {
+    uint32_t since = 0;
+    if (request->hasParam("since")) {
+      since = strtoul(request->getParam("since")->value().c_str(), nullptr, 10);
+    }
+    httpRequests++;
+
+    MatchDelta d;
+    takeDelta(since, d);
+
+    char json[MATCH_JSON_MAX];
+    JsonOut j(json, sizeof(json));
+    j.beginObject();
+    writeMatchDeltaJson(j, d);
+    j.endObject();
+    if (!j.finish()) {
+      request->send(500, "text/plain", "match record too large");
+      return;
+    }
+    request->send(200, "application/json", json);
+  });
+
+  Serial.println("🗂️ Match record on /match?since=N and SYNC N");
+}
+
+void matchSyncOnHit(const HitEvent& hit) {
+  portENTER_CRITICAL(&recordMux);
+  record.hit(hit.seq, hit.timeMs);
+  portEXIT_CRITICAL(&recordMux);
+}
+
+void matchSyncOnMatch(const MatchEvent& e) {
+  uint32_t now = millis();
+  portENTER_CRITICAL(&recordMux);
+  if (e.active) record.start(now);
+  else record.end(now);
+  portEXIT_CRITICAL(&recordMux);
+}
+
+size_t matchSyncEncode(uint32_t since, uint8_t* out, size_t cap) {
+  wsRequests++;
+  MatchDelta d;
+  takeDelta(since, d);
+  return encodeMatchDelta(d, out, cap);
+}
+
+void matchSyncWriteJson(JsonOut& j) {
+  j.beginObject("match");
+  j.field("version", record.head());
+  j.field("entries", (uint32_t)record.size());
+  j.field("number", record.summary().match);
+  j.field("hits", record.summary().hits);
+  j.field("http_syncs", httpRequests);
+  j.field("ws_syncs", wsRequests);
+  j.field("resets", resets);
+  j.endObject();
+}
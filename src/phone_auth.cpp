@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_random.h>
+#include <string.h>
+#include "phone_auth.h"
+#include "match_auth.h"
+
+extern const char* authSecret;   // hiddengems.cpp
+
+static MatchAuth auth;
+static uint16_t localPlaneId = 0;
+
+// auth.challenge() belongs to loop(); /auth/challenge runs on async_tcp
+// and reads this copy, which loop() republishes whenever it changes. A
+// 64-bit store is two writes on the S3, hence the lock.
+static portMUX_TYPE challengeMux = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t publishedChallenge = 0;
+
+static void publishChallenge() {
+  portENTER_CRITICAL(&challengeMux);
+  publishedChallenge = auth.challenge();
+  portEXIT_CRITICAL(&challengeMux);
+}
+
+static uint64_t randomChallenge() {
+  return (uint64_t)esp_random() << 32 | esp_random();
+}
+
+void phoneAuthBegin(AsyncWebServer& server, uint16_t planeId) {
+  localPlaneId = planeId;
+#if AUTH_ENABLED
+  auth.begin(authSecret, planeId, randomChallenge());
+  publishChallenge();
+
+  server.on("/auth/challenge", HTTP_GET, [](AsyncWebServerRequest* request) {
+    portENTER_CRITICAL(&challengeMux);
+    uint64_t chal = publishedChallenge;
+    portEXIT_CRITICAL(&challengeMux);
+
+    char json[48];
+    char hex[17];
+    authHex64(chal, hex);
+    hex[16] = '\0';
+    snprintf(json, sizeof(json), "{\"plane\":%u,\"challenge\":\"%s\"}",
+             (unsigned)localPlaneId, hex);
+    request->send(200, "application/json", json);
+  });
+
+  Serial.println("🔐 Commands and hits are signed (HMAC-SHA256)");
+#endif
+}
+
+PhoneCommand phoneAuthCommand(const char* data, size_t len) {
+#if AUTH_ENABLED
+  PhoneCommand cmd;
+  AuthResult r = auth.verifyCommand(data, len, cmd, randomChallenge());
+  if (cmd == CMD_MATCH_START) publishChallenge();
+  if (r != AUTH_OK) {
+    Serial.print("⛔ Rejected command, reason ");
+    Serial.println((int)r);
+  }
+  return cmd;
+#else
+  return parseCommand(data, len);
+#endif
+}
+
+size_t phoneAuthHitFrame(uint32_t seq, uint32_t timeMs, char* out, size_t cap) {
+#if AUTH_ENABLED
+  size_t n = auth.signHit(seq, timeMs, out, cap);
+  if (n > 0) return n;
+#else
+  (void)seq;
+  (void)timeMs;
+#endif
+  if (cap < 4) return 0;
+  memcpy(out, "HIT", 4);
+  return 3;
+}
+
+bool phoneAuthPacketTag(const uint8_t* pkt, uint8_t tag[HIT_PACKET_TAG]) {
+#if AUTH_ENABLED
+  return auth.tagPacket(pkt, tag);
+#else
+  (void)pkt;
+  (void)tag;
+  return false;
+#endif
+}
+
+bool phoneAuthFrameTag(const uint8_t* data, size_t len, uint8_t tag[HIT_PACKET_TAG]) {
+#if AUTH_ENABLED
+  return auth.tagFrame(data, len, tag);
+#else
+  (void)data;
+  (void)len;
+  (void)tag;
+  return false;
+#endif
+}
+
+void phoneAuthWriteJson(JsonOut& j) {
+  j.beginObject("auth");
+  j.field("enabled", (bool)AUTH_ENABLED);
+  j.field("match_key", auth.hasMatchKey());
+  j.field("accepted", auth.accepted);
+  j.field("unsigned", auth.rejected[AUTH_UNSIGNED]);
+  j.field("bad_format", auth.rejected[AUTH_BAD_FORMAT]);
+  j.field("bad_tag", auth.rejected[AUTH_BAD_TAG]);
+  j.field("replays", auth.rejected[AUTH_REPLAY]);
+  j.field("no_match", auth.rejected[AUTH_NO_MATCH]);
+  j.endObject();
+}
@@ -0,0 +1,133 @@
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_system.h>
+#include <esp_task_wdt.h>
+#include <esp_timer.h>
+#include "stall_watch.h"
+#include "stall_profiler.h"
+
+#define STALLS_JSON_MAX 3072
+#define WDT_MAGIC 0x57445431   // "WDT1"
+
+static const char* const loopStages[] = { "other", "camera", "broadcast", "log", "telemetry" };
+static const char* const netStages[]  = { "other", "http", "ws" };
+
+static StallProfiler profiler(STALL_RUN_THRESHOLD_US);
+static int loopTask = -1;
+static int netTask = -1;
+static uint32_t bootWifiWaitMs = 0;
+
+// ---------------------------
+// WATCHDOG RECORD (survives reset)
+// ---------------------------
+struct WdtRecord {
+  uint32_t magic;
+  uint32_t fired;
+  uint32_t uptimeMs;
+  uint8_t  loopStage;
+  uint8_t  netStage;
+};
+
+RTC_NOINIT_ATTR static WdtRecord wdtRecord;
+static WdtRecord previousBoot;
+static bool havePreviousBoot = false;
+
+// Called by ESP-IDF from the task watchdog interrupt (weak symbol).
+extern "C" void esp_task_wdt_isr_user_handler(void) {
+  if (wdtRecord.magic != WDT_MAGIC) {
+    wdtRecord.magic = WDT_MAGIC;
+    wdtRecord.fired = 0;
+  }
+  wdtRecord.fired++;
+  wdtRecord.uptimeMs = (uint32_t)(esp_timer_get_time() / 1000);
+  wdtRecord.loopStage = loopTask >= 0 ? profiler.currentStage(loopTask) : 0;
+  wdtRecord.netStage = netTask >= 0 ? profiler.currentStage(netTask) : 0;
+}
+
+static void writeWdt(JsonOut& j, const char* key, const WdtRecord& r) {
+  j.beginObject(key);
+  j.field("fired", r.fired);
+  j.field("uptime_ms", r.uptimeMs);
+  j.field("loop_stage", profiler.stageName(loopTask, r.loopStage));
+  j.field("net_stage", profiler.stageName(netTask, r.netStage));
+  j.endObject();
+}
+
+// ---------------------------
+// LOOP / NETWORK BRACKETS
+// ---------------------------
+void stallLoopBegin() {
+  profiler.begin(loopTask, micros());
+}
+
+void stallLoopStage(LoopStage stage) {
+  profiler.stage(loopTask, stage, micros());
+}
+
+void stallLoopEnd() {
+  profiler.end(loopTask, micros(), millis());
+  esp_task_wdt_reset();
+}
+
+StallNetScope::StallNetScope(NetStage stage) {
+  uint32_t now = micros();
+  profiler.begin(netTask, now);
+  profiler.stage(netTask, stage, now);
+}
+
+StallNetScope::~StallNetScope() {
+  profiler.end(netTask, micros(), millis());
+}
+
+void stallWatchReset() {
+  profiler.reset();
+}
+
+// ---------------------------
+// SETUP + /stalls
+// ---------------------------
+void stallWatchBegin(AsyncWebServer& server, uint32_t wifiWaitMs) {
+  bootWifiWaitMs = wifiWaitMs;
+
+  if (esp_reset_reason() == ESP_RST_TASK_WDT && wdtRecord.magic == WDT_MAGIC) {
+    previousBoot = wdtRecord;
+    havePreviousBoot = true;
+  }
+  wdtRecord.magic = 0;
+
+  loopTask = profiler.addTask("loop", loopStages, sizeof(loopStages) / sizeof(loopStages[0]),
+                              STALL_GAP_THRESHOLD_US);
+  // Requests arrive whenever the phone sends them; idle time is not a stall.
+  netTask = profiler.addTask("async_tcp", netStages, sizeof(netStages) / sizeof(netStages[0]), 0);
+
+  esp_task_wdt_init(STALL_WDT_TIMEOUT_S, STALL_WDT_RECOVER);
+  esp_task_wdt_add(NULL);   // loopTask
+
+  server.on("/stalls", HTTP_GET, [](AsyncWebServerRequest *request) {
+    StallNetScope scope(NET_STAGE_HTTP);
+    static char json[STALLS_JSON_MAX];
+
+    JsonOut j(json, sizeof(json));
+    j.beginObject();
+    j.field("uptime_ms", (uint32_t)millis());
+    j.field("run_threshold_us", profiler.runThresholdUs);
+    j.field("wifi_wait_ms", bootWifiWaitMs);
+    profiler.writeJson(j);
+
+    j.beginObject("watchdog");
+    j.field("timeout_s", (uint32_t)STALL_WDT_TIMEOUT_S);
+    j.field("recover", (bool)STALL_WDT_RECOVER);
+    if (wdtRecord.magic == WDT_MAGIC) writeWdt(j, "this_boot", wdtRecord);
+    if (havePreviousBoot) writeWdt(j, "previous_boot", previousBoot);
+    j.endObject();
+
+    j.endObject();
+    request->send(200, "application/json", j.finish() ? json : "{}");
+  });
+
+  if (havePreviousBoot) {
+    Serial.print("⚠️ Reset by task watchdog, loop stage: ");
+    Serial.println(profiler.stageName(loopTask, previousBoot.loopStage));
+  }
+}
@@ -0,0 +1,208 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <AsyncTCP.h>
+#include <ESPAsyncWebServer.h>
+#include <esp_freertos_hooks.h>
+#include <esp_heap_caps.h>
+#include "telemetry.h"
+#include "telemetry_codec.h"
+#include "hit_pipeline.h"
+#include "heap_track.h"
+#include "udp_hits.h"
+#include "camera_inputs.h"
+
+static AsyncWebSocket tws("/telemetry");
+static const HitPipeline* hits = nullptr;
+static TelemetryEncoder encoder;
+
+static volatile uint32_t periodMs = TELEMETRY_PERIOD_MS;
+static volatile bool keyframeNeeded = false;
+static uint32_t lastSendMs = 0;
+static uint32_t lastCamLines = 0;
+static uint32_t dropped = 0;
+
+// ---------------------------
+// LOOP PERIOD / JITTER
+// ---------------------------
+static uint32_t lastTickUs = 0;
+static uint32_t prevPeriodUs = 0;
+static uint64_t periodSumUs = 0;
+static uint32_t jitterSumUs = 0;
+static uint32_t periodCount = 0;
+static uint32_t periodMaxUs = 0;
+
+void telemetryLoopTick() {
+  uint32_t now = micros();
+  if (lastTickUs) {
+    uint32_t p = now - lastTickUs;
+    periodSumUs += p;
+    periodCount++;
+    if (prevPeriodUs) jitterSumUs += (p > prevPeriodUs) ? p - prevPeriodUs : prevPeriodUs - p;
+    if (p > periodMaxUs) periodMaxUs = p;
+    prevPeriodUs = p;
+  }
+  lastTickUs = now;
+}
+
+// ---------------------------
+// CPU LOAD (idle hooks)
+// ---------------------------
+// While a client is connected each core's idle task spins through this
+// hook; gaps shorter than IDLE_GAP_CYCLES count as idle time, longer
+// ones mean another task (or a long ISR) ran. Hooks are removed when
+// the last client leaves so the idle task can sleep again.
+#define IDLE_GAP_CYCLES 24000   // 100 us at 240 MHz
+
+static uint32_t idleLast[2];
+static uint32_t idleCycles[2];
+static uint32_t windowStart[2];
+static bool hooksOn = false;
+
+static bool IRAM_ATTR idleHook(int core) {
+  uint32_t now = ESP.getCycleCount();
+  uint32_t gap = now - idleLast[core];
+  if (gap < IDLE_GAP_CYCLES) idleCycles[core] += gap;
+  idleLast[core] = now;
+  return false;
+}
+
+static bool idleHook0() { return idleHook(0); }
+static bool idleHook1() { return idleHook(1); }
+
+static void setIdleHooks(bool on) {
+  if (on == hooksOn) return;
+  if (on) {
+    esp_register_freertos_idle_hook_for_cpu(idleHook0, 0);
+    esp_register_freertos_idle_hook_for_cpu(idleHook1, 1);
+  } else {
+    esp_deregister_freertos_idle_hook_for_cpu(idleHook0, 0);
+    esp_deregister_freertos_idle_hook_for_cpu(idleHook1, 1);
+  }
+  hooksOn = on;
+}
+
+// Percent busy since the previous call; read from the loop task, so
+// the other core's counters may be a few cycles stale.
+static int32_t cpuLoad(int core) {
+  uint32_t now = ESP.getCycleCount();
+  uint32_t window = now - windowStart[core];
+  uint32_t idle = idleCycles[core];
+  idleCycles[core] = 0;
+  windowStart[core] = now;
+  if (!hooksOn || window == 0) return -1;
+  if (idle > window) idle = window;
+  return (int32_t)(100 - (uint64_t)idle * 100 / window);
+}
+
+// ---------------------------
+// SAMPLE + SEND
+// ---------------------------
+static void takeSample(TelemetrySample& s, uint32_t now, uint32_t dtMs) {
+  int32_t* v = s.values;
+  s.timeMs = now;
+
+  v[TELEM_RSSI_DBM] = WiFi.RSSI();
+  v[TELEM_CPU0_PCT] = cpuLoad(0);
+  v[TELEM_CPU1_PCT] = cpuLoad(1);
+
+  v[TELEM_LOOP_PERIOD_US] = periodCount ? (int32_t)(periodSumUs / periodCount) : 0;
+  v[TELEM_LOOP_JITTER_US] = periodCount > 1 ? (int32_t)(jitterSumUs / (periodCount - 1)) : 0;
+  v[TELEM_LOOP_MAX_US] = (int32_t)periodMaxUs;
+  periodSumUs = 0;
+  jitterSumUs = 0;
+  periodCount = 0;
+  periodMaxUs = 0;
+
+  v[TELEM_CAM_RX_QUEUE] = (int32_t)cameraInputsPending();
+  v[TELEM_UDP_PENDING] = udpHitsPending();
+  v[TELEM_WS_CLIENTS] = (int32_t)tws.count();
+
+  v[TELEM_HEAP_FREE] = (int32_t)heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  v[TELEM_HEAP_LARGEST] = (int32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  v[TELEM_HEAP_MIN] = (int32_t)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+
+  uint32_t lines = hits->camLines;
+  v[TELEM_CAM_LINES_PS] = dtMs ? (int32_t)((lines - lastCamLines) * 1000u / dtMs) : 0;
+  lastCamLines = lines;
+
+  v[TELEM_HITS] = (int32_t)hits->lastSeq();
+  v[TELEM_HITS_IGNORED] = (int32_t)hits->hitsIgnored;
+  v[TELEM_CAM_UNKNOWN] = (int32_t)hits->unknownLines;
+  v[TELEM_CAM_OVERFLOWS] = (int32_t)hits->overflows();
+
+  uint32_t failed = 0;
+  for (int i = 0; i < HEAP_SYS_COUNT; i++) failed += heapTrackStats((HeapSubsystem)i).failed;
+  v[TELEM_HEAP_FAILED] = (int32_t)failed;
+}
+
+void telemetryPoll() {
+  uint32_t now = millis();
+  uint32_t dt = now - lastSendMs;
+  if (dt < periodMs) return;
+  if (cameraInputsPending()) return;   // hits first
+
+  if (tws.count() == 0) {
+    lastSendMs = now;
+    return;
+  }
+
+  if (!tws.availableForWriteAll()) {
+    dropped++;
+    lastSendMs = now;
+    return;
+  }
+
+  if (keyframeNeeded) {
+    keyframeNeeded = false;
+    encoder.forceKeyframe();
+  }
+
+  TelemetrySample s;
+  takeSample(s, now, dt);
+
+  uint8_t buf[TELEM_RECORD_MAX];
+  size_t len = encoder.encode(s, buf, sizeof(buf));
+  if (len) tws.binaryAll((const char*)buf, len);
+  lastSendMs = now;
+}
+
+// ---------------------------
+// WEBSOCKET
+// ---------------------------
+static void handleRate(const char* data, size_t len) {
+  char text[16];
+  if (len < 6 || len >= sizeof(text) || memcmp(data, "RATE ", 5) != 0) return;
+  memcpy(text, data, len);
+  text[len] = '\0';
+
+  long ms = atol(text + 5);
+  if (ms < TELEMETRY_MIN_PERIOD_MS) ms = TELEMETRY_MIN_PERIOD_MS;
+  if (ms > TELEMETRY_MAX_PERIOD_MS) ms = TELEMETRY_MAX_PERIOD_MS;
+  periodMs = (uint32_t)ms;
+}
+
+void telemetryBegin(AsyncWebServer& server, const HitPipeline& pipeline) {
+  hits = &pipeline;
+
+  tws.onEvent([](AsyncWebSocket *server,
+                 AsyncWebSocketClient *client,
+                 AwsEventType type,
+                 void *arg,
+                 uint8_t *data,
+                 size_t len)
+  {
+    if (type == WS_EVT_CONNECT) {
+      keyframeNeeded = true;
+      setIdleHooks(true);
+      Serial.println("📈 Telemetry client connected");
+    }
+    else if (type == WS_EVT_DISCONNECT) {
+      if (server->count() == 0) setIdleHooks(false);
+    }
+    else if (type == WS_EVT_DATA) {
+      handleRate((const char*)data, len);
+    }
+  });
+
+  server.addHandler(&tws);
+}
@@ -0,0 +1,138 @@
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include <esp_timer.h>
+#include <esp_random.h>
+#include <string.h>
+#include "udp_hits.h"
+#include "hit_packet.h"
+#include "phone_auth.h"
+#include "pools.h"
+
+static AsyncUDP udp;
+static IPAddress group(UDP_HIT_GROUP);
+static esp_timer_handle_t copyTimer = nullptr;
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint16_t localPlaneId = 0;
+static uint16_t bootId = 0;
+
+// Hits whose extra copies are still queued, owned until the last copy.
+// Each keeps its own due time, so a hit that arrives while the timer is
+// already running for an earlier one still gets full spacing.
+static RadioPacket* pending[POOL_RADIO_PACKETS];
+static int64_t pendingDueUs[POOL_RADIO_PACKETS];
+static uint8_t pendingCount = 0;
+
+static void sendPacket(const RadioPacket& hit) {
+  uint8_t buf[HIT_PACKET_AUTH_SIZE];
+  encodeHitPacket(hit.pkt, buf);
+  size_t len = HIT_PACKET_SIZE;
+  if (hit.tagged) {
+    memcpy(buf + HIT_PACKET_SIZE, hit.tag, HIT_PACKET_TAG);
+    len = HIT_PACKET_AUTH_SIZE;
+  }
+
+#if UDP_HIT_BROADCAST
+  udp.broadcastTo(buf, len, UDP_HIT_PORT);
+#else
+  udp.writeTo(buf, len, group, UDP_HIT_PORT);
+#endif
+}
+
+// ---------------------------
+// REDUNDANT COPIES (esp_timer task)
+// ---------------------------
+static void onCopyTimer(void*) {
+  RadioPacket* batch[POOL_RADIO_PACKETS];
+  uint8_t n = 0;
+  int64_t now = esp_timer_get_time();
+  int64_t next = INT64_MAX;
+
+  portENTER_CRITICAL(&pendingMux);
+  uint8_t keep = 0;
+  for (uint8_t i = 0; i < pendingCount; i++) {
+    RadioPacket* hit = pending[i];
+    int64_t due = pendingDueUs[i];
+    bool last = false;
+    if (due <= now) {
+      hit->pkt.copy++;
+      batch[n++] = hit;
+      last = hit->pkt.copy + 1 >= hit->pkt.copies;
+      due += UDP_HIT_COPY_SPACING_MS * 1000;
+    }
+    if (last) continue;
+    pending[keep] = hit;
+    pendingDueUs[keep++] = due;
+    if (due < next) next = due;
+  }
+  pendingCount = keep;
+  portEXIT_CRITICAL(&pendingMux);
+
+  // Only this task touches a packet once it is pending.
+  for (uint8_t i = 0; i < n; i++) {
+    sendPacket(*batch[i]);
+    if (batch[i]->pkt.copy + 1 >= batch[i]->pkt.copies) radioPacketPool.release(batch[i]);
+  }
+
+  if (keep > 0) esp_timer_start_once(copyTimer, next > now ? (uint64_t)(next - now) : 0);
+}
+
+// ---------------------------
+// PUBLIC API
+// ---------------------------
+void udpHitsBegin(uint16_t planeId) {
+#if UDP_HIT_ENABLED
+  localPlaneId = planeId;
+  bootId = (uint16_t)esp_random();
+
+  esp_timer_create_args_t args = {};
+  args.callback = onCopyTimer;
+  args.name = "udp_hit_copy";
+  esp_timer_create(&args, &copyTimer);
+
+  Serial.print("📡 UDP hits on port ");
+  Serial.print(UDP_HIT_PORT);
+  Serial.print(" x");
+  Serial.println(UDP_HIT_COPIES);
+#endif
+}
+
+void udpHitsSend(uint32_t seq, uint32_t timeMs) {
+#if UDP_HIT_ENABLED
+  // Without a pooled packet the hit still goes out once, from the stack.
+  RadioPacket spare;
+  RadioPacket* hit = (UDP_HIT_COPIES > 1) ? radioPacketPool.acquire() : nullptr;
+  if (!hit) hit = &spare;
+
+  HitPacket& pkt = hit->pkt;
+  pkt.type = HIT_PACKET_HIT;
+  pkt.planeId = localPlaneId;
+  pkt.bootId = bootId;
+  pkt.seq = seq;
+  pkt.timeMs = timeMs;
+  pkt.copy = 0;
+  pkt.copies = UDP_HIT_COPIES;
+
+  uint8_t buf[HIT_PACKET_SIZE];
+  encodeHitPacket(pkt, buf);
+  hit->tagged = phoneAuthPacketTag(buf, hit->tag);
+
+  sendPacket(*hit);
+  if (hit == &spare) return;
+
+  // Every pooled packet fits: pending holds at most the whole pool. A
+  // running timer is due no later than this hit, and re-arms for it.
+  int64_t due = esp_timer_get_time() + UDP_HIT_COPY_SPACING_MS * 1000;
+  portENTER_CRITICAL(&pendingMux);
+  pending[pendingCount] = hit;
+  pendingDueUs[pendingCount++] = due;
+  bool startTimer = (pendingCount == 1);
+  portEXIT_CRITICAL(&pendingMux);
+
+  if (startTimer) esp_timer_start_once(copyTimer, UDP_HIT_COPY_SPACING_MS * 1000);
+#endif
+}
+
+uint8_t udpHitsPending() {
+  return pendingCount;
+}
@@ -0,0 +1,412 @@
+// ---------------------------
+// LORA CHANNEL SIMULATOR (Linux)
+// ---------------------------
+// Runs the real LoraRateController + LoraRateSync on both ends of a
+// simulated plane <-> ground link and compares adaptive rate against
+// every fixed rate on the ladder, on the same channel realisation.
+//
+// Channel, per frame and direction:
+//   path loss   log-distance, exponent --n, plane orbiting between
+//               --d-min and --d-max metres every --period-s
+//   shadowing   Gauss-Markov, --shadow-db sigma, 5 s correlation
+//   blockage    --blockage-db extra for --blockage-s every --blockage-every-s
+//   fading      Rician, --k-db
+//   noise       -174 dBm/Hz + 10log10(BW) + --nf-db
+// A frame decodes with a logistic probability around the SF's floor,
+// only if the receiver is on the same rate for the whole frame and is
+// not transmitting itself (half duplex).
+//
+// Plane hits are signed with a real match key (MatchAuth, after a signed
+// MATCH_START) and the ground checks every tag before counting a hit.
+// --forge-rate adds an attacker on the channel who sends well-formed HIT
+// frames without the key; they must all be rejected.
+//
+//   pio run -e lora_sim
+//   .pio/build/lora_sim/program --duration-s 900 --hit-rate 0.2
+//   .pio/build/lora_sim/program --mode adaptive --trace     (rate changes)
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lora_rate.h"
+#include "lora_sync.h"
+#include "match_auth.h"
+
+#define TICK_MS 1
+#define POLL_MS 20          // loop() period on both ends
+#define HIT_QUEUE_MAX 8
+#define PLANE_ID 1
+#define SIM_SECRET "sim secret"
+#define SIM_NONCE 2
+#define SIM_CHALLENGE 1
+#define ALOHA_CAPACITY 0.18 // pure ALOHA peak throughput
+
+struct Options {
+  double   durationS = 900;
+  double   hitRate = 0.2;      // per second
+  double   forgeRate = 0;      // forged HIT frames per second
+  double   dMin = 100, dMax = 4000, periodS = 180;
+  double   n = 2.7;
+  double   shadowDb = 4;
+  double   kDb = 10;
+  double   txDbm = 17;
+  double   nfDb = 6;
+  double   blockageDb = 12, blockageS = 6, blockageEveryS = 90;
+  float    targetLoss = 0.05f;
+  float    marginDb = 3.0f;
+  uint32_t seed = 7;
+  std::string mode = "all";
+  bool     trace = false;
+  bool     json = false;
+};
+
+// ---------------------------
+// CHANNEL
+// ---------------------------
+class Channel {
+public:
+  Channel(const Options& o) : rng(o.seed), o(o), gauss(0, 1), uni(0, 1) {}
+
+  // Path loss + shadowing + blockage at time t (same for both directions).
+  double meanLossDb(double tS) {
+    while (shadowT < tS) {
+      double a = exp(-0.01 / 5.0);   // 10 ms steps, 5 s correlation
+      shadow = a * shadow + sqrt(1 - a * a) * o.shadowDb * gauss(rng);
+      shadowT += 0.01;
+    }
+    double mid = (o.dMin + o.dMax) / 2, amp = (o.dMax - o.dMin) / 2;
+    double d = mid - amp * cos(2 * M_PI * tS / o.periodS);
+    double pl = 31.7 + 10 * o.n * log10(d);   // 915 MHz, 1 m reference
+    bool blocked = o.blockageEveryS > 0 && fmod(tS, o.blockageEveryS) > o.blockageEveryS - o.blockageS;
+    return pl + shadow + (blocked ? o.blockageDb : 0);
+  }
+
+  // One frame: SNR at the receiver.
+  double frameSnr(double tS, uint32_t bwHz) {
+    double k = pow(10, o.kDb / 10);
+    double los = sqrt(k / (k + 1));
+    double sc = sqrt(1 / (2 * (k + 1)));
+    double re = los + sc * gauss(rng), im = sc * gauss(rng);
+    double fadeDb = 10 * log10(re * re + im * im);
+    double noise = -174 + 10 * log10((double)bwHz) + o.nfDb;
+    return o.txDbm - meanLossDb(tS) + fadeDb - noise;
+  }
+
+  bool decodes(double snr, float floorDb) {
+    return uni(rng) < 1.0 / (1.0 + exp(-(snr - floorDb) / 0.7));
+  }
+
+  // What the radio reports (quantised, noisy, clamped like packetSnr()).
+  float reportedSnr(double snr) {
+    double r = round((snr + 0.5 * gauss(rng)) * 4) / 4;
+    return (float)std::max(-32.0, std::min(31.75, r));
+  }
+
+  std::mt19937 rng;
+
+private:
+  const Options& o;
+  std::normal_distribution<double> gauss;
+  std::uniform_real_distribution<double> uni;
+  double shadow = 0, shadowT = 0;
+};
+
+// ---------------------------
+// LINK ENDS
+// ---------------------------
+struct InFlight {
+  int      from;        // 0 plane, 1 ground, 2 forger
+  uint8_t  bytes[LORA_FRAME_MAX];
+  size_t   len;
+  int      rate;
+  uint32_t startMs, endMs;
+  bool     corrupted;   // receiver transmitted meanwhile
+};
+
+struct End {
+  LoraRateSync sync;
+  uint32_t     busyUntil = 0;
+  uint32_t     txMs = 0;
+  uint32_t     seenChanges = 0;
+  float        rxSnrEwma = 0;
+  bool         rxSnrInit = false;
+
+  End(LoraRole role, int rate, const LoraSyncConfig& c) : sync(role, PLANE_ID, rate, c) {}
+};
+
+struct Result {
+  std::string name;
+  uint32_t hits = 0, delivered = 0, dropped = 0;
+  uint32_t forged = 0, rejected = 0, forgedAccepted = 0;
+  uint64_t planeAirMs = 0, groundAirMs = 0;
+  uint32_t switches = 0, reverts = 0, abandoned = 0, fallbacks = 0;
+  uint64_t rateMs[LORA_RATE_COUNT] = {};
+};
+
+static Result run(const Options& o, bool adaptive, int fixedRate) {
+  Channel ch(o);
+  std::mt19937 traffic(o.seed * 31 + 1);
+  std::exponential_distribution<double> gap(o.hitRate);
+
+  LoraSyncConfig sc;
+  if (!adaptive) sc.baseRate = fixedRate;   // no fallback either
+  LoraRateConfig rc;
+  rc.targetLoss = o.targetLoss;
+  rc.marginDb = o.marginDb;
+
+  int start = adaptive ? LORA_RATE_SLOWEST : fixedRate;
+  End plane(LORA_ROLE_PLANE, start, sc), ground(LORA_ROLE_GROUND, start, sc);
+  LoraRateController ctl(rc);
+
+  // Plane keyed by a signed MATCH_START; the ground derives the same key.
+  static MatchAuth planeAuth;
+  HmacSha256 planeKey, groundKey;
+  authPlaneKey(planeKey, SIM_SECRET, PLANE_ID);
+  planeAuth.begin(SIM_SECRET, PLANE_ID, SIM_CHALLENGE);
+  char startLine[AUTH_LINE_MAX];
+  PhoneCommand cmd;
+  size_t startLen = authSignMatchStart(planeKey, SIM_NONCE, SIM_CHALLENGE, startLine, sizeof(startLine));
+  planeAuth.verifyCommand(startLine, startLen, cmd, SIM_CHALLENGE + 1);
+  authMatchKey(groundKey, planeKey, SIM_NONCE, SIM_CHALLENGE);
+
+  std::mt19937 forger(o.seed * 31 + 2);
+  std::exponential_distribution<double> forgeGap(o.forgeRate > 0 ? o.forgeRate : 1);
+  double nextForge = o.forgeRate > 0 ? forgeGap(forger) * 1000 : 1e18;
+
+  Result r;
+  r.name = adaptive ? "adaptive" : "SF" + std::to_string(loraRates[fixedRate].sf) + "/" +
+                                   std::to_string(loraRates[fixedRate].bwHz / 1000);
+
+  std::vector<InFlight> air;
+  std::vector<uint32_t> hitQueue;
+  uint32_t hitSeq = 0;
+  uint32_t durationMs = (uint32_t)(o.durationS * 1000);
+  double nextHit = gap(traffic) * 1000;
+
+  auto onAir = [&](int from, const uint8_t* bytes, size_t len, int rate, uint32_t now) {
+    uint32_t ms = loraAirtimeUs(loraRates[rate], sc.codingRate4, len) / 1000 + 1;
+    for (InFlight& a : air) if (a.from != from) a.corrupted = true;   // half duplex
+    InFlight a = { from, {}, len, rate, now, now + ms, false };
+    memcpy(a.bytes, bytes, len);
+    air.push_back(a);
+    return ms;
+  };
+
+  auto transmit = [&](End& e, int from, const LoraFrame& f, uint32_t now) {
+    uint8_t buf[LORA_FRAME_MAX], tag[HIT_PACKET_TAG];
+    size_t n = encodeLoraFrame(f, buf);
+    if (f.type == LORA_FRAME_HIT && planeAuth.tagFrame(buf, LORA_FRAME_HIT_SIGNED, tag)) {
+      n = loraFrameSetTag(buf, tag);
+    }
+    uint32_t ms = onAir(from, buf, n, e.sync.rate(), now);
+    e.busyUntil = now + ms;
+    e.txMs += ms;
+  };
+
+  for (uint32_t now = 0; now < durationMs; now += TICK_MS) {
+    double t = now / 1000.0;
+    r.rateMs[ground.sync.rate()] += TICK_MS;
+
+    // --- deliveries ---
+    for (size_t i = 0; i < air.size();) {
+      InFlight& a = air[i];
+      if (a.endMs > now) { i++; continue; }
+
+      End& rx = a.from == 1 ? plane : ground;
+      if (a.from == 0) plane.sync.onSent(now);
+      if (a.from == 1) ground.sync.onSent(now);
+
+      const LoraRate& lr = loraRates[a.rate];
+      double snr = ch.frameSnr(t, lr.bwHz);
+      LoraFrame fr;
+      bool ok = !a.corrupted && rx.sync.rate() == a.rate && rx.busyUntil <= a.startMs &&
+                ch.decodes(snr, lr.floorDb) && decodeLoraFrame(a.bytes, a.len, fr);
+
+      // The ground drops hits without a valid tag before anything else sees them.
+      if (ok && a.from != 1 && fr.type == LORA_FRAME_HIT &&
+          !(fr.tagged && authCheckTag(groundKey, a.bytes, LORA_FRAME_HIT_SIGNED, fr.tag))) {
+        r.rejected++;
+        ok = false;
+      } else if (ok && a.from == 2) {
+        r.forgedAccepted++;
+        ok = false;
+      }
+
+      if (ok) {
+        float rep = ch.reportedSnr(snr);
+        float rssi = (float)(o.txDbm - ch.meanLossDb(t));
+        if (a.from == 0) {
+          ctl.onReceived(fr.linkSeq, rep, rssi, a.rate, now);
+          ground.sync.setPeerSnr(ctl.snr());
+          if (fr.type == LORA_FRAME_HIT) r.delivered++;
+        } else {
+          plane.rxSnrEwma = plane.rxSnrInit ? plane.rxSnrEwma + 0.2f * (rep - plane.rxSnrEwma) : rep;
+          plane.rxSnrInit = true;
+          plane.sync.setPeerSnr(plane.rxSnrEwma);
+        }
+        rx.sync.onFrame(fr, now);
+      }
+      air.erase(air.begin() + (long)i);
+    }
+
+    // --- hits from the camera ---
+    while (nextHit <= now) {
+      r.hits++;
+      if (hitQueue.size() < HIT_QUEUE_MAX) hitQueue.push_back(++hitSeq);
+      else r.dropped++;
+      nextHit += gap(traffic) * 1000;
+    }
+
+    // --- forger: right plane id and rate, random tag ---
+    while (nextForge <= now) {
+      LoraFrame f = LoraFrame();
+      f.type = LORA_FRAME_HIT;
+      f.planeId = PLANE_ID;
+      f.linkSeq = (uint16_t)forger();
+      f.epoch = ground.sync.epoch();
+      f.rate = (uint8_t)ground.sync.rate();
+      f.hitSeq = forger();
+      f.hitTimeMs = now;
+      f.tagged = true;
+      for (uint8_t& b : f.tag) b = (uint8_t)forger();
+      uint8_t buf[LORA_FRAME_MAX];
+      size_t n = encodeLoraFrame(f, buf);
+      onAir(2, buf, n, ground.sync.rate(), now);
+      r.forged++;
+      nextForge += forgeGap(forger) * 1000;
+    }
+
+    if (now % POLL_MS != 0) continue;
+
+    // --- ground loop ---
+    if (ground.sync.changes != ground.seenChanges) {
+      ground.seenChanges = ground.sync.changes;
+      ctl.onRateChanged(now);
+      if (o.trace) printf("%8.1f s  rate -> SF%u/%u  snr %.1f  loss %.3f\n", t,
+                          loraRates[ground.sync.rate()].sf, loraRates[ground.sync.rate()].bwHz / 1000,
+                          ctl.snr(), ctl.loss());
+    }
+    if (adaptive && ground.sync.state() == LORA_SYNC_STABLE) {
+      int want = ctl.decide(ground.sync.rate(), now);
+      if (want != ground.sync.rate()) ground.sync.request(want, now);
+    }
+    LoraFrame f;
+    if (ground.busyUntil <= now && ground.sync.poll(now, f)) transmit(ground, 1, f, now);
+
+    // --- plane loop: link control first, then queued hits ---
+    if (plane.busyUntil <= now) {
+      if (plane.sync.poll(now, f)) {
+        transmit(plane, 0, f, now);
+      } else if (!hitQueue.empty() && plane.sync.hitClear(now)) {
+        f = LoraFrame();
+        f.type = LORA_FRAME_HIT;
+        plane.sync.stamp(f);
+        f.hitSeq = hitQueue.front();
+        f.hitTimeMs = now;
+        hitQueue.erase(hitQueue.begin());
+        transmit(plane, 0, f, now);
+      }
+    }
+  }
+
+  r.planeAirMs = plane.txMs;
+  r.groundAirMs = ground.txMs;
+  r.switches = ground.sync.switches;
+  r.reverts = ground.sync.reverts + plane.sync.reverts;
+  r.abandoned = ground.sync.abandoned;
+  r.fallbacks = ground.sync.fallbacks + plane.sync.fallbacks;
+  return r;
+}
+
+// ---------------------------
+// REPORT
+// ---------------------------
+static void report(const Result& r, const Options& o) {
+  double dur = o.durationS * 1000;
+  double delivery = r.hits ? (double)r.delivered / r.hits : 0;
+  double airPerHit = r.delivered ? (double)r.planeAirMs / r.delivered : 0;
+  double occupancy = (double)(r.planeAirMs + r.groundAirMs) / dur;
+  double planes = occupancy > 0 ? ALOHA_CAPACITY / occupancy : 0;
+
+  if (o.json) {
+    printf("{\"mode\":\"%s\",\"hits\":%u,\"delivered\":%u,\"delivery\":%.4f,\"queue_drops\":%u,"
+           "\"air_ms_per_hit\":%.1f,\"occupancy\":%.5f,\"planes_per_channel\":%.1f,"
+           "\"switches\":%u,\"reverts\":%u,\"abandoned\":%u,\"fallbacks\":%u,"
+           "\"forged\":%u,\"rejected\":%u,\"forged_accepted\":%u}\n",
+           r.name.c_str(), r.hits, r.delivered, delivery, r.dropped, airPerHit, occupancy,
+           planes, r.switches, r.reverts, r.abandoned, r.fallbacks, r.forged, r.rejected,
+           r.forgedAccepted);
+    return;
+  }
+
+  printf("%-10s delivered %5u/%-5u %6.2f%%  air/hit %7.1f ms  occupancy %6.2f%%  planes/ch %6.1f",
+         r.name.c_str(), r.delivered, r.hits, 100 * delivery, airPerHit, 100 * occupancy, planes);
+  if (r.forged) printf("  forged %u rejected %u accepted %u", r.forged, r.rejected, r.forgedAccepted);
+  if (r.name == "adaptive") {
+    printf("  switches %u reverts %u abandoned %u fallbacks %u\n           time at rate:",
+           r.switches, r.reverts, r.abandoned, r.fallbacks);
+    for (int i = 0; i < LORA_RATE_COUNT; i++) {
+      if (r.rateMs[i]) printf(" SF%u/%u %.0f%%", loraRates[i].sf, loraRates[i].bwHz / 1000,
+                              100.0 * r.rateMs[i] / dur);
+    }
+  }
+  printf("\n");
+}
+
+static void usage() {
+  fprintf(stderr,
+      "usage: lora_channel_sim [--mode all|adaptive|fixed:N] [--duration-s S] [--hit-rate R]\n"
+      "                        [--forge-rate R]\n"
+      "                        [--d-min M] [--d-max M] [--period-s S] [--n EXP]\n"
+      "                        [--shadow-db DB] [--k-db DB] [--tx-dbm DBM] [--nf-db DB]\n"
+      "                        [--blockage-db DB] [--blockage-s S] [--blockage-every-s S]\n"
+      "                        [--target-loss P] [--margin-db DB] [--seed N] [--trace] [--json]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  Options o;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+
+    if (a == "--mode") o.mode = next();
+    else if (a == "--duration-s") o.durationS = atof(next());
+    else if (a == "--hit-rate") o.hitRate = atof(next());
+    else if (a == "--forge-rate") o.forgeRate = atof(next());
+    else if (a == "--d-min") o.dMin = atof(next());
+    else if (a == "--d-max") o.dMax = atof(next());
+    else if (a == "--period-s") o.periodS = atof(next());
+    else if (a == "--n") o.n = atof(next());
+    else if (a == "--shadow-db") o.shadowDb = atof(next());
+    else if (a == "--k-db") o.kDb = atof(next());
+    else if (a == "--tx-dbm") o.txDbm = atof(next());
+    else if (a == "--nf-db") o.nfDb = atof(next());
+    else if (a == "--blockage-db") o.blockageDb = atof(next());
+    else if (a == "--blockage-s") o.blockageS = atof(next());
+    else if (a == "--blockage-every-s") o.blockageEveryS = atof(next());
+    else if (a == "--target-loss") o.targetLoss = (float)atof(next());
+    else if (a == "--margin-db") o.marginDb = (float)atof(next());
+    else if (a == "--seed") o.seed = (uint32_t)atoi(next());
+    else if (a == "--trace") o.trace = true;
+    else if (a == "--json") o.json = true;
+    else usage();
+  }
+  if (o.hitRate <= 0 || o.forgeRate < 0 || o.durationS <= 0 || o.dMin <= 0 || o.dMax < o.dMin) usage();
+
+  if (o.mode == "all" || o.mode == "adaptive") report(run(o, true, 0), o);
+  for (int i = 0; i < LORA_RATE_COUNT; i++) {
+    if (o.mode == "all" || o.mode == "fixed:" + std::to_string(i)) report(run(o, false, i), o);
+  }
+  return 0;
+}
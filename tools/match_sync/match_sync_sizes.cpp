@@ -0,0 +1,165 @@
+// ---------------------------
+// MATCH SYNC PAYLOAD SIZES (Linux)
+// ---------------------------
+// Fills a MatchRecord with one match (start, hits at random intervals,
+// end) and measures what a phone that missed the last K entries pays to
+// catch up: number of deltas (pages), binary bytes (SYNC N over /ws),
+// JSON bytes (/match?since=N), and encode / decode time per catch-up.
+// K = "all" is a phone joining with since = 0.
+//
+//   pio run -e match_sync
+//   .pio/build/match_sync/program --hits 200 --interval-ms 1500
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+#include "json_out.h"
+#include "match_record.h"
+
+struct Options {
+  int  hits       = 200;
+  int  intervalMs = 1500;
+  int  reps       = 2000;
+  bool json       = false;
+};
+
+struct CatchUp {
+  int      pages = 0;
+  size_t   binBytes = 0;
+  size_t   jsonBytes = 0;
+  uint32_t entries = 0;
+};
+
+static CatchUp catchUp(const MatchRecord& r, uint32_t since) {
+  CatchUp c;
+  MatchDelta d, back;
+  uint8_t bin[MATCH_DELTA_BYTES_MAX];
+  static char json[8192];
+
+  do {
+    r.delta(since, d);
+    size_t n = encodeMatchDelta(d, bin, sizeof(bin));
+    if (!decodeMatchDelta(bin, n, back) || back.to != d.to) {
+      fprintf(stderr, "round trip failed at since=%u\n", (unsigned)since);
+      exit(1);
+    }
+    JsonOut j(json, sizeof(json));
+    j.beginObject();
+    writeMatchDeltaJson(j, d);
+    j.endObject();
+
+    c.pages++;
+    c.binBytes += n;
+    c.jsonBytes += j.finish();
+    c.entries += d.count;
+    since = d.to;
+  } while (d.to < d.head);
+  return c;
+}
+
+// Mean ns for encode (delta + encode) and decode of the whole catch-up.
+static void timeCatchUp(const MatchRecord& r, uint32_t since, int reps,
+                        double& encodeNs, double& decodeNs) {
+  typedef std::chrono::steady_clock clock;
+  static uint8_t bins[64][MATCH_DELTA_BYTES_MAX];
+  static size_t lens[64];
+  MatchDelta d;
+  int pages = 0;
+  uint32_t acc = 0;
+
+  clock::time_point t0 = clock::now();
+  for (int i = 0; i < reps; i++) {
+    uint32_t s = since;
+    pages = 0;
+    do {
+      r.delta(s, d);
+      lens[pages] = encodeMatchDelta(d, bins[pages], MATCH_DELTA_BYTES_MAX);
+      pages++;
+      s = d.to;
+    } while (d.to < d.head && pages < 64);
+  }
+  clock::time_point t1 = clock::now();
+  for (int i = 0; i < reps; i++) {
+    for (int p = 0; p < pages; p++) {
+      decodeMatchDelta(bins[p], lens[p], d);
+      acc += d.to;
+    }
+  }
+  clock::time_point t2 = clock::now();
+  if (acc == 1) puts("");
+
+  encodeNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / reps;
+  decodeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / reps;
+}
+
+static void usage() {
+  fprintf(stderr,
+      "usage: match_sync_sizes [--hits N] [--interval-ms N] [--reps N] [--json]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  Options o;
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+
+    if (a == "--hits") o.hits = atoi(next());
+    else if (a == "--interval-ms") o.intervalMs = atoi(next());
+    else if (a == "--reps") o.reps = atoi(next());
+    else if (a == "--json") o.json = true;
+    else usage();
+  }
+  if (o.hits < 0 || o.intervalMs < 1 || o.reps < 1) usage();
+
+  static MatchRecord record(0x5eed);
+  std::mt19937 rng(7);
+  std::exponential_distribution<double> gap(1.0 / o.intervalMs);
+
+  uint32_t t = 60000;
+  record.start(t);
+  for (int i = 1; i <= o.hits; i++) {
+    t += 1 + (uint32_t)gap(rng);
+    record.hit((uint32_t)i, t);
+  }
+  record.end(t + 5000);
+
+  const int missed[] = { 1, 2, 4, 8, 16, 32, 64, 128, -1 };
+  if (!o.json) {
+    printf("record: %u entries kept, head %u\n",
+           (unsigned)record.size(), (unsigned)record.head());
+    printf("missed  entries  pages  binary B  json B  bin B/entry  encode us  decode us\n");
+  }
+
+  for (int k : missed) {
+    uint32_t head = record.head();
+    if (k > 0 && (uint32_t)k > head) continue;
+    uint32_t since = k < 0 ? 0 : head - (uint32_t)k;
+
+    CatchUp c = catchUp(record, since);
+    double enc, dec;
+    timeCatchUp(record, since, o.reps, enc, dec);
+    double perEntry = c.entries ? (double)c.binBytes / c.entries : 0;
+
+    if (o.json) {
+      printf("{\"since\":%u,\"entries\":%u,\"pages\":%d,\"binary_bytes\":%zu,"
+             "\"json_bytes\":%zu,\"encode_ns\":%.0f,\"decode_ns\":%.0f}\n",
+             (unsigned)since, (unsigned)c.entries, c.pages, c.binBytes, c.jsonBytes, enc, dec);
+    } else {
+      char label[12];
+      if (k < 0) snprintf(label, sizeof(label), "all");
+      else snprintf(label, sizeof(label), "%d", k);
+      printf("%-6s  %7u  %5d  %8zu  %6zu  %11.1f  %9.2f  %9.2f\n",
+             label, (unsigned)c.entries, c.pages, c.binBytes, c.jsonBytes,
+             perEntry, enc / 1000, dec / 1000);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,228 @@
+// ---------------------------
+// CAMERA CAPTURE REPLAY (Linux)
+// ---------------------------
+// Feeds a capture downloaded from GET /capture through the same
+// HitPipeline the plane runs, with the recorded cameras, byte chunking,
+// arrival times, match start / end edges and merge releases, so the
+// cameras are merged the way the plane merged them. The output is
+// deterministic: the
+// same capture always prints the same hits and counters, so a parser
+// change can be checked against a real match before it is flashed.
+//
+//   pio run -e camera_replay
+//   .pio/build/camera_replay/program capture.bin               # as fast as possible
+//   .pio/build/camera_replay/program capture.bin --speed 1     # real time
+//   .pio/build/camera_replay/program capture.bin --bench 200   # throughput
+//
+// --speed 0 (default) ignores the recorded timing for pacing; hit times
+// still come from the capture.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "capture_format.h"
+#include "hit_pipeline.h"
+
+struct Options {
+  const char* path   = nullptr;
+  double      speed  = 0.0;
+  int         bench  = 0;
+  bool        quiet  = false;
+  bool        json   = false;
+};
+
+struct ReplayResult {
+  uint32_t records    = 0;
+  uint64_t bytes      = 0;
+  uint32_t hits       = 0;
+  uint32_t matchEdges = 0;
+  int64_t  lastUs     = 0;
+  bool     truncated  = false;
+};
+
+static bool printHits = false;
+
+static void onHit(const HitEvent& hit) {
+  if (printHits) printf("HIT seq=%u t=%u ms\n", hit.seq, hit.timeMs);
+}
+
+static int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static bool readFile(const char* path, std::vector<uint8_t>& out) {
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+  fclose(f);
+  return true;
+}
+
+// ---------------------------
+// REPLAY
+// ---------------------------
+static ReplayResult replay(const CaptureHeader& h, const uint8_t* data, size_t len,
+                           HitPipeline& pipeline, double speed) {
+  ReplayResult r;
+  CaptureReader reader(data, len, h.version);
+  CaptureRecord rec;
+  int64_t wallStart = nowUs();
+  int64_t baseUs = (int64_t)h.startMs * 1000;
+
+  pipeline.setSink(onHit);
+
+  while (reader.next(rec)) {
+    if (speed > 0) {
+      int64_t due = wallStart + (int64_t)((double)rec.timeUs / speed);
+      int64_t wait = due - nowUs();
+      if (wait > 0) std::this_thread::sleep_for(std::chrono::microseconds(wait));
+    }
+
+    int64_t at = baseUs + rec.timeUs;
+    uint64_t atUs = at > 0 ? (uint64_t)at : 0;
+    r.records++;
+    if (rec.timeUs > r.lastUs) r.lastUs = rec.timeUs;
+
+    switch (rec.kind) {
+      case CAPTURE_BYTES:
+        r.bytes += rec.len;
+        pipeline.feedCamera(rec.cam, rec.data, rec.len, atUs);
+        // Version 1: one camera, nothing to wait for.
+        if (h.version < 2) r.hits += pipeline.releaseHits(atUs);
+        break;
+      case CAPTURE_RELEASE:
+        r.hits += pipeline.releaseHits(atUs);
+        break;
+      case CAPTURE_MATCH_START:
+      case CAPTURE_MATCH_END:
+        pipeline.setMatchActive(rec.kind == CAPTURE_MATCH_START);
+        r.matchEdges++;
+        break;
+    }
+  }
+
+  // The capture stopped with hits still held in the merge.
+  r.hits += pipeline.releaseHits(UINT64_MAX);
+  r.truncated = reader.truncated;
+  return r;
+}
+
+static void report(const CaptureHeader& h, const ReplayResult& r,
+                   const HitPipeline& p, const Options& o) {
+  if (o.json) {
+    printf("{\"plane_id\":%u,\"version\":%u,\"records\":%u,\"bytes\":%llu,"
+           "\"duration_ms\":%llu,\"match_edges\":%u,\"hits\":%u,\"hits_ignored\":%u,"
+           "\"cam_lines\":%u,\"cam_unknown\":%u,\"cam_overflows\":%u,\"cam_late\":%u,"
+           "\"cameras\":[",
+           h.planeId, h.version, r.records, (unsigned long long)r.bytes,
+           (unsigned long long)(r.lastUs / 1000), r.matchEdges, r.hits,
+           p.hitsIgnored, p.camLines, p.unknownLines, p.overflows(), p.merger().late);
+    for (uint8_t cam = 0; cam < CAPTURE_CAMERAS_MAX; cam++) {
+      const CameraInputStats& s = p.input(cam);
+      printf("%s{\"cam\":%u,\"bytes\":%u,\"lines\":%u,\"hits\":%u,\"duplicates\":%u}",
+             cam ? "," : "", cam, s.bytes, s.lines, s.hits, p.merger().duplicates[cam]);
+    }
+    printf("],\"truncated\":%s}\n", r.truncated ? "true" : "false");
+    return;
+  }
+
+  printf("plane %u  v%u  %u records  %llu bytes  %.1f s  %u match edges\n",
+         h.planeId, h.version, r.records, (unsigned long long)r.bytes,
+         (double)r.lastUs / 1e6, r.matchEdges);
+  printf("hits %u  ignored %u  lines %u  unknown %u  overflows %u  late %u\n",
+         r.hits, p.hitsIgnored, p.camLines, p.unknownLines, p.overflows(), p.merger().late);
+  for (uint8_t cam = 0; cam < CAPTURE_CAMERAS_MAX; cam++) {
+    const CameraInputStats& s = p.input(cam);
+    if (s.bytes == 0) continue;
+    printf("  cam %u  bytes %u  lines %u  hits %u  duplicates %u\n",
+           cam, s.bytes, s.lines, s.hits, p.merger().duplicates[cam]);
+  }
+  if (r.truncated) printf("warning: capture ends in a truncated record\n");
+}
+
+// ---------------------------
+// BENCH
+// ---------------------------
+// Replays the whole capture N times on fresh pipelines, no pacing.
+static void bench(const CaptureHeader& h, const uint8_t* data, size_t len, const Options& o) {
+  uint64_t bytes = 0;
+  uint64_t lines = 0;
+  int64_t t0 = nowUs();
+
+  for (int i = 0; i < o.bench; i++) {
+    HitPipeline p;
+    ReplayResult r = replay(h, data, len, p, 0);
+    bytes += r.bytes;
+    lines += p.camLines;
+  }
+
+  double s = (double)(nowUs() - t0) / 1e6;
+  if (o.json) {
+    printf("{\"bench_rounds\":%d,\"seconds\":%.4f,\"mb_per_s\":%.2f,\"lines_per_s\":%.0f}\n",
+           o.bench, s, (double)bytes / s / 1e6, (double)lines / s);
+  } else {
+    printf("bench %d rounds  %.3f s  %.2f MB/s  %.0f lines/s\n",
+           o.bench, s, (double)bytes / s / 1e6, (double)lines / s);
+  }
+}
+
+static void usage() {
+  fprintf(stderr,
+      "usage: camera_replay <capture.bin> [--speed X] [--bench N] [--quiet] [--json]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  Options o;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+
+    if (a == "--speed") o.speed = atof(next());
+    else if (a == "--bench") o.bench = atoi(next());
+    else if (a == "--quiet") o.quiet = true;
+    else if (a == "--json") o.json = true;
+    else if (a[0] != '-' && !o.path) o.path = argv[i];
+    else usage();
+  }
+  if (!o.path || o.speed < 0 || o.bench < 0) usage();
+
+  std::vector<uint8_t> file;
+  if (!readFile(o.path, file)) {
+    perror(o.path);
+    return 1;
+  }
+
+  CaptureHeader h;
+  if (!decodeCaptureHeader(file.data(), file.size(), h)) {
+    fprintf(stderr, "%s: not a camera capture\n", o.path);
+    return 1;
+  }
+
+  const uint8_t* body = file.data() + CAPTURE_HEADER_SIZE;
+  size_t bodyLen = file.size() - CAPTURE_HEADER_SIZE;
+
+  if (o.bench > 0) {
+    bench(h, body, bodyLen, o);
+    return 0;
+  }
+
+  printHits = !o.quiet && !o.json;
+  HitPipeline pipeline;
+  ReplayResult r = replay(h, body, bodyLen, pipeline, o.speed);
+  report(h, r, pipeline, o);
+  return r.truncated ? 1 : 0;
+}
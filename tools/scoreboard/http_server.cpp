@@ -0,0 +1,154 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "http_server.h"
+#include "ws_proto.h"
+
+#define HTTP_REQUEST_MAX 8192
+
+struct HttpServer::Client {
+  int         fd;
+  bool        listener;
+  std::string in;
+  std::string out;
+  size_t      sent = 0;
+};
+
+static const char* statusText(int status) {
+  switch (status) {
+    case 200: return "OK";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    default:  return "Error";
+  }
+}
+
+bool HttpServer::listen(uint16_t port, HttpHandler h) {
+  handler = h;
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  lfd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  int one = 1;
+  setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in a = {};
+  a.sin_family = AF_INET;
+  a.sin_port = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_ANY);
+  if (bind(lfd, (sockaddr*)&a, sizeof(a)) != 0 || ::listen(lfd, 64) != 0) return false;
+
+  listenClient = new Client();
+  listenClient->fd = lfd;
+  listenClient->listener = true;
+  epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.ptr = listenClient;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, lfd, &ev);
+  return true;
+}
+
+HttpServer::~HttpServer() {
+  if (lfd >= 0) close(lfd);
+  if (epfd >= 0) close(epfd);
+  delete listenClient;
+}
+
+void HttpServer::finish(Client* c) {
+  close(c->fd);
+  delete c;
+}
+
+void HttpServer::onClient(Client* c, uint32_t events) {
+  if (c->out.empty()) {
+    char buf[2048];
+    ssize_t n;
+    while ((n = recv(c->fd, buf, sizeof(buf), 0)) > 0) c->in.append(buf, (size_t)n);
+    if (n == 0 || (n < 0 && errno != EAGAIN) || c->in.size() > HTTP_REQUEST_MAX) {
+      finish(c);
+      return;
+    }
+
+    size_t end = httpHeaderEnd(c->in);
+    if (!end) return;
+
+    HttpRequest req;
+    HttpResponse res;
+    size_t sp1 = c->in.find(' ');
+    size_t sp2 = c->in.find(' ', sp1 + 1);
+    if (sp1 == std::string::npos || sp2 == std::string::npos) {
+      res.status = 400;
+    } else {
+      req.method = c->in.substr(0, sp1);
+      std::string target = c->in.substr(sp1 + 1, sp2 - sp1 - 1);
+      size_t q = target.find('?');
+      req.path = target.substr(0, q);
+      if (q != std::string::npos) req.query = target.substr(q + 1);
+      handler(req, res);
+    }
+
+    c->out = "HTTP/1.1 " + std::to_string(res.status) + " " + statusText(res.status) +
+             "\r\nContent-Type: " + res.type +
+             "\r\nContent-Length: " + std::to_string(res.body.size()) +
+             "\r\nAccess-Control-Allow-Origin: *\r\nConnection: close\r\n\r\n" + res.body;
+
+    epoll_event ev = {};
+    ev.events = EPOLLOUT;
+    ev.data.ptr = c;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, c->fd, &ev);
+    events |= EPOLLOUT;
+  }
+
+  if (events & EPOLLOUT) {
+    while (c->sent < c->out.size()) {
+      ssize_t n = send(c->fd, c->out.data() + c->sent, c->out.size() - c->sent, MSG_NOSIGNAL);
+      if (n < 0 && errno == EAGAIN) return;
+      if (n <= 0) break;
+      c->sent += (size_t)n;
+    }
+    finish(c);
+  }
+}
+
+void HttpServer::poll(int timeoutMs) {
+  epoll_event events[64];
+  int n = epoll_wait(epfd, events, 64, timeoutMs);
+
+  for (int i = 0; i < n; i++) {
+    Client* c = (Client*)events[i].data.ptr;
+    if (!c->listener) {
+      onClient(c, events[i].events);
+      continue;
+    }
+
+    int fd;
+    while ((fd = accept4(lfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+      Client* nc = new Client();
+      nc->fd = fd;
+      nc->listener = false;
+      epoll_event ev = {};
+      ev.events = EPOLLIN;
+      ev.data.ptr = nc;
+      epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+    }
+  }
+}
+
+long queryLong(const std::string& query, const char* key, long def) {
+  size_t n = strlen(key);
+  size_t pos = 0;
+  while (pos < query.size()) {
+    size_t amp = query.find('&', pos);
+    if (amp == std::string::npos) amp = query.size();
+    if (amp - pos > n && query.compare(pos, n, key) == 0 && query[pos + n] == '=') {
+      return strtol(query.c_str() + pos + n + 1, nullptr, 10);
+    }
+    pos = amp + 1;
+  }
+  return def;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+#include <string>
+
+// ---------------------------
+// TINY HTTP SERVER (epoll, one request per connection)
+// ---------------------------
+// Enough for the standings API: GET / POST without bodies, responses
+// built in one piece, Connection: close.
+
+struct HttpRequest {
+  std::string method;
+  std::string path;
+  std::string query;   // without '?'
+};
+
+struct HttpResponse {
+  int         status = 200;
+  const char* type = "application/json";
+  std::string body;
+};
+
+typedef std::function<void(const HttpRequest&, HttpResponse&)> HttpHandler;
+
+class HttpServer {
+public:
+  bool listen(uint16_t port, HttpHandler handler);
+
+  // Serves for at most timeoutMs.
+  void poll(int timeoutMs);
+
+  ~HttpServer();
+
+private:
+  struct Client;
+  void onClient(Client* c, uint32_t events);
+  void finish(Client* c);
+
+  int         epfd = -1;
+  int         lfd = -1;
+  Client*     listenClient = nullptr;
+  HttpHandler handler;
+};
+
+// Value of key in a query string, or def.
+long queryLong(const std::string& query, const char* key, long def);
@@ -0,0 +1,416 @@
+// ---------------------------
+// AERODUEL SCOREBOARD (Linux)
+// ---------------------------
+// Phone stand-in for a whole field: finds planes over mDNS (or takes
+// them from --plane), holds a /ws connection to each from a few epoll
+// worker threads, merges every plane's hits into one time-ordered match
+// timeline and serves live standings over HTTP:
+//
+//   GET  /standings               planes sorted by hits
+//   GET  /timeline?since=N&limit=M merged hit events from index N
+//   GET  /stats                   links, throughput, merge lag
+//   POST /match/start, /match/end sent to every plane as MATCH_START / MATCH_END
+//
+// With --simulate N it also runs N fake planes on localhost, which makes
+// it the bench for how many planes one ground station can referee:
+//
+//   pio run -e scoreboard
+//   .pio/build/scoreboard/program --simulate 500 --sim-rate 5 --match-s 20 --workers 4
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "http_server.h"
+#include "json_out.h"
+#include "mdns_browse.h"
+#include "plane_link.h"
+#include "scoreboard.h"
+#include "sim_planes.h"
+
+#define JSON_BUF_MAX (256 * 1024)
+#define TIMELINE_PAGE_MAX 2000
+
+struct Options {
+  int      workers     = 2;
+  uint16_t httpPort    = 8080;
+  bool     mdns        = true;
+  int      mdnsEveryMs = 5000;
+  double   warmupS     = 2.0;
+  double   matchS      = 0;      // 0 = matches only via POST /match/*
+  double   durationS   = 0;      // 0 = until Ctrl-C
+  int      reorderMs   = 20;
+  size_t   timelineMax = 4 * 1024 * 1024;
+  bool     json        = false;
+  SimOptions sim;
+  std::vector<std::string> planes;   // id@ip:port
+};
+
+static std::atomic<bool> stopping(false);
+static SimFleet* simFleet = nullptr;
+
+static int64_t simSent(int plane, uint32_t seq) {
+  return simFleet->sentNs(plane, seq);
+}
+
+static void onSignal(int) {
+  stopping = true;
+}
+
+// ---------------------------
+// SHARED STATE
+// ---------------------------
+struct Server {
+  Scoreboard   board;
+  MatchControl match;
+  Timeline*    timeline = nullptr;
+  std::vector<std::unique_ptr<LinkWorker>> workers;
+  int64_t      startNs = 0;
+  std::atomic<int64_t> matchStartNs{0};
+  std::atomic<int64_t> matchEndNs{0};
+
+  // One thread at a time: main before start, then the mDNS thread.
+  void assign(int slot) {
+    while (!workers[slot % workers.size()]->addPlane(slot)) std::this_thread::yield();
+  }
+
+  void setMatch(bool active) {
+    if (match.active.load() == active) return;
+    int64_t now = monoNs();
+    if (active) {
+      board.resetHits();
+      matchStartNs = now;
+      matchEndNs = 0;
+    } else {
+      matchEndNs = now;
+    }
+    match.active = active;
+    match.gen++;
+    for (auto& w : workers) w->wake();
+  }
+
+  uint32_t msSinceStart(int64_t ns) const {
+    return ns ? (uint32_t)((ns - startNs) / 1000000) : 0;
+  }
+};
+
+// ---------------------------
+// HTTP API
+// ---------------------------
+static void writeStandings(Server& s, JsonOut& j) {
+  std::vector<Standing> st;
+  s.board.standings(st);
+  int64_t now = monoNs();
+  int64_t ms = s.matchStartNs.load();
+  int64_t me = s.matchEndNs.load();
+
+  j.beginObject();
+  j.field("match_active", s.match.active.load());
+  j.field("match_ms", ms ? (uint32_t)(((me ? me : now) - ms) / 1000000) : 0u);
+  j.field("total_hits", (uint32_t)s.board.totalHits.load());
+  j.beginArray("planes");
+  uint32_t rank = 0;
+  for (const Standing& p : st) {
+    j.beginObject();
+    j.field("rank", ++rank);
+    j.field("id", (uint32_t)p.id);
+    j.field("name", p.name);
+    j.field("hits", p.hits);
+    j.field("connected", p.connected);
+    j.field("connects", p.connects);
+    j.field("disconnects", p.disconnects);
+    j.field("last_hit_ms", s.msSinceStart(p.lastHitNs));
+    j.endObject();
+  }
+  j.endArray();
+  j.endObject();
+}
+
+static void writeTimeline(Server& s, JsonOut& j, size_t since, size_t limit) {
+  size_t n = s.timeline->size();
+  size_t end = std::min(n, since + limit);
+
+  j.beginObject();
+  j.field("size", (uint32_t)n);
+  j.field("next", (uint32_t)std::max(since, end));
+  j.beginArray("events");
+  for (size_t i = since; i < end; i++) {
+    const TimelineEvent& e = s.timeline->at(i);
+    j.beginObject();
+    j.field("i", (uint32_t)i);
+    j.field("t_ms", s.msSinceStart(e.arrivalNs));
+    j.field("plane", (uint32_t)s.board.slot(e.plane).id);
+    j.field("seq", e.planeSeq);
+    j.endObject();
+  }
+  j.endArray();
+  j.endObject();
+}
+
+static void writeStats(Server& s, JsonOut& j) {
+  uint64_t frames = 0, bytes = 0, fails = 0, qfull = 0;
+  uint32_t open = 0;
+  for (auto& w : s.workers) {
+    frames += w->framesIn;
+    bytes += w->bytesIn;
+    fails += w->connectFailures;
+    qfull += w->queueFull;
+    open += w->open;
+  }
+
+  j.beginObject();
+  j.field("uptime_ms", s.msSinceStart(monoNs()));
+  j.field("workers", (uint32_t)s.workers.size());
+  j.field("planes", (uint32_t)s.board.size());
+  j.field("links_open", open);
+  j.field("frames_in", (uint32_t)frames);
+  j.field("bytes_in", (uint32_t)bytes);
+  j.field("connect_failures", (uint32_t)fails);
+  j.field("queue_full", (uint32_t)qfull);
+  j.field("timeline", (uint32_t)s.timeline->size());
+  j.field("reorder_ms", (uint32_t)(s.timeline->reorderNs / 1000000));
+  LagSnapshot lag;
+  s.timeline->publishLag.snapshot(lag);
+  j.field("merge_lag_p50_us", (int32_t)lag.percentileUs(0.5));
+  j.field("merge_lag_p99_us", (int32_t)lag.percentileUs(0.99));
+  j.endObject();
+}
+
+static void handleHttp(Server& s, const HttpRequest& req, HttpResponse& res) {
+  std::vector<char> buf(JSON_BUF_MAX);
+  JsonOut j(buf.data(), buf.size());
+
+  if (req.method == "GET" && req.path == "/standings") {
+    writeStandings(s, j);
+  } else if (req.method == "GET" && req.path == "/timeline") {
+    long since = std::max(0L, queryLong(req.query, "since", 0));
+    long limit = std::min((long)TIMELINE_PAGE_MAX, std::max(1L, queryLong(req.query, "limit", 500)));
+    writeTimeline(s, j, (size_t)since, (size_t)limit);
+  } else if (req.method == "GET" && req.path == "/stats") {
+    writeStats(s, j);
+  } else if (req.method == "POST" && (req.path == "/match/start" || req.path == "/match/end")) {
+    s.setMatch(req.path == "/match/start");
+    writeStandings(s, j);
+  } else {
+    res.status = 404;
+    res.type = "text/plain";
+    res.body = "not found\n";
+    return;
+  }
+
+  size_t n = j.finish();
+  res.body.assign(buf.data(), n);
+}
+
+// ---------------------------
+// REPORT
+// ---------------------------
+static int64_t pct(std::vector<int64_t>& v, double p) {
+  if (v.empty()) return -1;
+  size_t i = (size_t)(p * (double)(v.size() - 1) + 0.5);
+  std::nth_element(v.begin(), v.begin() + i, v.end());
+  return v[i];
+}
+
+static void report(Server& s, const Options& o) {
+  uint64_t frames = 0, fails = 0, qfull = 0;
+  uint32_t connected = 0;
+  for (auto& w : s.workers) {
+    frames += w->framesIn;
+    fails += w->connectFailures;
+    qfull += w->queueFull;
+  }
+  for (size_t i = 0; i < s.board.size(); i++) connected += s.board.slot((int)i).connects > 0;
+
+  std::vector<int64_t> deliver;   // sim send -> worker read
+  for (size_t i = 0; i < s.timeline->size(); i++) {
+    const TimelineEvent& e = s.timeline->at(i);
+    if (e.sentNs) deliver.push_back(e.arrivalNs - e.sentNs);
+  }
+  LagSnapshot lag;
+  s.timeline->publishLag.snapshot(lag);
+  uint64_t simSentHits = simFleet ? simFleet->hitsSent.load() : 0;
+
+  if (o.json) {
+    printf("{\"planes\":%zu,\"connected\":%u,\"workers\":%zu,\"sim_hits_sent\":%llu,"
+           "\"hits\":%llu,\"timeline\":%zu,\"frames\":%llu,\"connect_failures\":%llu,"
+           "\"queue_full\":%llu,\"out_of_order\":%llu,"
+           "\"deliver_p50_us\":%lld,\"deliver_p99_us\":%lld,\"deliver_max_us\":%lld,"
+           "\"merge_p50_us\":%lld,\"merge_p99_us\":%lld}\n",
+           s.board.size(), connected, s.workers.size(), (unsigned long long)simSentHits,
+           (unsigned long long)s.board.totalHits.load(), s.timeline->size(),
+           (unsigned long long)frames, (unsigned long long)fails, (unsigned long long)qfull,
+           (unsigned long long)s.timeline->outOfOrder,
+           (long long)pct(deliver, 0.5) / 1000, (long long)pct(deliver, 0.99) / 1000,
+           (long long)pct(deliver, 1.0) / 1000,
+           (long long)lag.percentileUs(0.5), (long long)lag.percentileUs(0.99));
+    return;
+  }
+
+  printf("planes %zu (connected %u) on %zu workers\n", s.board.size(), connected, s.workers.size());
+  printf("hits %llu scored, %zu in timeline", (unsigned long long)s.board.totalHits.load(),
+         s.timeline->size());
+  if (simFleet) printf(", %llu sent by simulated planes", (unsigned long long)simSentHits);
+  printf("\nframes %llu  connect failures %llu  queue full %llu  out of order %llu\n",
+         (unsigned long long)frames, (unsigned long long)fails, (unsigned long long)qfull,
+         (unsigned long long)s.timeline->outOfOrder);
+  if (!deliver.empty()) {
+    printf("plane -> scoreboard   p50 %6lld  p99 %6lld  max %6lld us\n",
+           (long long)pct(deliver, 0.5) / 1000, (long long)pct(deliver, 0.99) / 1000,
+           (long long)pct(deliver, 1.0) / 1000);
+  }
+  printf("timeline merge lag    p50 %6lld  p99 %6lld us (reorder window %d ms)\n",
+         (long long)lag.percentileUs(0.5), (long long)lag.percentileUs(0.99), o.reorderMs);
+}
+
+// ---------------------------
+// MAIN
+// ---------------------------
+static void usage() {
+  fprintf(stderr,
+      "usage: scoreboard [--plane ID@IP:PORT]... [--no-mdns] [--mdns-every-ms N]\n"
+      "                  [--workers N] [--http-port N] [--reorder-ms N]\n"
+      "                  [--warmup-s S] [--match-s S] [--duration-s S] [--json]\n"
+      "                  [--simulate N] [--sim-port N] [--sim-rate HITS_PER_S]\n"
+      "                  [--sim-threads N] [--seed N]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  Options o;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+
+    if (a == "--plane") o.planes.push_back(next());
+    else if (a == "--no-mdns") o.mdns = false;
+    else if (a == "--mdns-every-ms") o.mdnsEveryMs = atoi(next());
+    else if (a == "--workers") o.workers = atoi(next());
+    else if (a == "--http-port") o.httpPort = (uint16_t)atoi(next());
+    else if (a == "--reorder-ms") o.reorderMs = atoi(next());
+    else if (a == "--warmup-s") o.warmupS = atof(next());
+    else if (a == "--match-s") o.matchS = atof(next());
+    else if (a == "--duration-s") o.durationS = atof(next());
+    else if (a == "--json") o.json = true;
+    else if (a == "--simulate") o.sim.planes = atoi(next());
+    else if (a == "--sim-port") o.sim.basePort = (uint16_t)atoi(next());
+    else if (a == "--sim-rate") o.sim.hitsPerSec = atof(next());
+    else if (a == "--sim-threads") o.sim.threads = atoi(next());
+    else if (a == "--seed") o.sim.seed = (uint32_t)atoi(next());
+    else usage();
+  }
+  if (o.workers < 1 || o.sim.planes < 0 || o.sim.threads < 1 || o.reorderMs < 0) usage();
+  if (o.sim.planes > SCOREBOARD_MAX_PLANES) o.sim.planes = SCOREBOARD_MAX_PLANES;
+
+  signal(SIGINT, onSignal);
+  signal(SIGTERM, onSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+  std::unique_ptr<Server> s(new Server());
+  Timeline timeline(o.timelineMax, (int64_t)o.reorderMs * 1000000);
+  s->timeline = &timeline;
+  s->startNs = monoNs();
+
+  // --- simulated planes take the first slots, so slot == sim index ---
+  SimFleet sim;
+  if (o.sim.planes > 0) {
+    if (!sim.start(o.sim, stopping)) return 1;
+    simFleet = &sim;
+    for (int i = 0; i < o.sim.planes; i++) {
+      std::string name = "Sim " + std::to_string(i + 1);
+      s->board.addPlane((uint16_t)(i + 1), name.c_str(), "127.0.0.1",
+                        (uint16_t)(o.sim.basePort + i));
+    }
+  }
+
+  for (const std::string& p : o.planes) {
+    unsigned id, port;
+    char ip[64];
+    if (sscanf(p.c_str(), "%u@%63[^:]:%u", &id, ip, &port) != 3) usage();
+    s->board.addPlane((uint16_t)id, ("Plane " + std::to_string(id)).c_str(), ip, (uint16_t)port);
+  }
+
+  // --- link workers ---
+  for (int i = 0; i < o.workers; i++) {
+    s->workers.emplace_back(new LinkWorker(s->board, s->match));
+    if (simFleet) s->workers.back()->sentLookup = simSent;
+    timeline.addQueue(&s->workers.back()->queue);
+  }
+  for (size_t i = 0; i < s->board.size(); i++) s->assign((int)i);
+
+  std::vector<std::thread> threads;
+  for (auto& w : s->workers) {
+    LinkWorker* wp = w.get();
+    threads.emplace_back([wp] { wp->run(stopping); });
+  }
+
+  std::atomic<bool> mergerStop(false);
+  std::thread merger([&] {
+    while (!mergerStop.load()) {
+      timeline.mergeStep(monoNs(), false);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    timeline.mergeStep(monoNs(), true);
+  });
+
+  if (o.mdns) {
+    Server* sp = s.get();
+    threads.emplace_back([sp, &o] {
+      mdnsBrowse(stopping, o.mdnsEveryMs, [sp](const DiscoveredPlane& d) {
+        size_t before = sp->board.size();
+        int slot = sp->board.addPlane(d.id, d.name.c_str(), d.ip.c_str(), d.port);
+        if (slot < 0 || sp->board.size() == before) return;
+        fprintf(stderr, "found plane %u \"%s\" at %s:%u\n", d.id, d.name.c_str(), d.ip.c_str(), d.port);
+        sp->assign(slot);
+      });
+    });
+  }
+
+  // --- HTTP + match schedule on this thread ---
+  HttpServer http;
+  Server* sp = s.get();
+  if (!http.listen(o.httpPort, [sp](const HttpRequest& req, HttpResponse& res) {
+        handleHttp(*sp, req, res);
+      })) {
+    perror("http listen");
+    return 1;
+  }
+  if (!o.json) printf("standings on http://0.0.0.0:%u/standings\n", o.httpPort);
+
+  bool matchStarted = false;
+  while (!stopping.load()) {
+    http.poll(50);
+    double t = (double)(monoNs() - s->startNs) / 1e9;
+
+    if (o.matchS > 0 && !matchStarted && t >= o.warmupS) {
+      s->setMatch(true);
+      matchStarted = true;
+    }
+    if (o.matchS > 0 && matchStarted && s->match.active && t >= o.warmupS + o.matchS) {
+      s->setMatch(false);
+      if (o.durationS <= 0) o.durationS = t + 0.5;   // drain, then report
+    }
+    if (o.durationS > 0 && t >= o.durationS) stopping = true;
+  }
+
+  for (auto& w : s->workers) w->wake();
+  for (std::thread& t : threads) t.join();
+  mergerStop = true;
+  merger.join();
+  if (simFleet) sim.join();
+
+  report(*s, o);
+  return 0;
+}
@@ -0,0 +1,181 @@
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "mdns_browse.h"
+
+#define MDNS_PORT 5353
+#define MDNS_GROUP "224.0.0.251"
+#define SERVICE_NAME "_aeroduel._tcp.local"
+
+#define DNS_A   1
+#define DNS_PTR 12
+#define DNS_TXT 16
+#define DNS_SRV 33
+
+// ---------------------------
+// DNS NAMES
+// ---------------------------
+static void putName(std::vector<uint8_t>& out, const char* name) {
+  while (*name) {
+    const char* dot = strchr(name, '.');
+    size_t n = dot ? (size_t)(dot - name) : strlen(name);
+    out.push_back((uint8_t)n);
+    out.insert(out.end(), name, name + n);
+    name += n + (dot ? 1 : 0);
+  }
+  out.push_back(0);
+}
+
+// Reads a possibly compressed name at *off; advances *off past it.
+static bool readName(const uint8_t* pkt, size_t len, size_t* off, std::string& name) {
+  size_t p = *off;
+  bool jumped = false;
+  int hops = 0;
+  name.clear();
+
+  while (p < len) {
+    uint8_t n = pkt[p];
+    if (n == 0) {
+      if (!jumped) *off = p + 1;
+      return true;
+    }
+    if ((n & 0xC0) == 0xC0) {
+      if (p + 1 >= len || ++hops > 16) return false;
+      if (!jumped) *off = p + 2;
+      jumped = true;
+      p = (size_t)(n & 0x3F) << 8 | pkt[p + 1];
+      continue;
+    }
+    if (p + 1 + n > len) return false;
+    if (!name.empty()) name += '.';
+    name.append((const char*)pkt + p + 1, n);
+    p += 1 + n;
+  }
+  return false;
+}
+
+static uint16_t get16(const uint8_t* p) {
+  return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+// ---------------------------
+// RESPONSE PARSING
+// ---------------------------
+struct Instance {
+  uint16_t    port = 0;
+  std::string target;
+  std::string name;
+  int         id = -1;
+};
+
+void mdnsParseResponse(const uint8_t* pkt, size_t len, const DiscoveryCallback& found) {
+  if (len < 12) return;
+  size_t records = (size_t)get16(pkt + 6) + get16(pkt + 8) + get16(pkt + 10);
+  size_t off = 12;
+  std::string name;
+
+  for (uint16_t q = get16(pkt + 4); q > 0; q--) {
+    if (!readName(pkt, len, &off, name) || off + 4 > len) return;
+    off += 4;
+  }
+
+  std::map<std::string, Instance> instances;
+  std::map<std::string, std::string> addresses;
+  std::vector<std::string> ptrs;
+
+  for (size_t r = 0; r < records; r++) {
+    if (!readName(pkt, len, &off, name) || off + 10 > len) return;
+    uint16_t type = get16(pkt + off);
+    uint16_t rdlen = get16(pkt + off + 8);
+    off += 10;
+    if (off + rdlen > len) return;
+    const uint8_t* rd = pkt + off;
+
+    if (type == DNS_PTR && strcasecmp(name.c_str(), SERVICE_NAME) == 0) {
+      size_t p = off;
+      std::string inst;
+      if (readName(pkt, len, &p, inst)) ptrs.push_back(inst);
+    } else if (type == DNS_SRV && rdlen >= 7) {
+      size_t p = off + 6;
+      Instance& i = instances[name];
+      i.port = get16(rd + 4);
+      readName(pkt, len, &p, i.target);
+    } else if (type == DNS_TXT) {
+      Instance& i = instances[name];
+      for (size_t p = 0; p < rdlen; p += 1 + rd[p]) {
+        std::string kv((const char*)rd + p + 1, std::min<size_t>(rd[p], rdlen - p - 1));
+        if (kv.compare(0, 3, "id=") == 0) i.id = atoi(kv.c_str() + 3);
+        else if (kv.compare(0, 5, "name=") == 0) i.name = kv.substr(5);
+      }
+    } else if (type == DNS_A && rdlen == 4) {
+      char ip[INET_ADDRSTRLEN];
+      inet_ntop(AF_INET, rd, ip, sizeof(ip));
+      addresses[name] = ip;
+    }
+    off += rdlen;
+  }
+
+  for (const std::string& inst : ptrs) {
+    auto it = instances.find(inst);
+    if (it == instances.end()) continue;
+    const Instance& i = it->second;
+    auto addr = addresses.find(i.target);
+    if (i.id < 0 || i.port == 0 || addr == addresses.end()) continue;
+
+    DiscoveredPlane d;
+    d.id = (uint16_t)i.id;
+    d.name = i.name.empty() ? inst.substr(0, inst.find('.')) : i.name;
+    d.ip = addr->second;
+    d.port = i.port;
+    found(d);
+  }
+}
+
+// ---------------------------
+// BROWSE LOOP
+// ---------------------------
+bool mdnsBrowse(const std::atomic<bool>& stop, int intervalMs, const DiscoveryCallback& found) {
+  int fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) return false;
+
+  timeval tv = { 0, 200000 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+  std::vector<uint8_t> query = { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+  putName(query, SERVICE_NAME);
+  query.insert(query.end(), { 0, DNS_PTR, 0, 1 });
+
+  sockaddr_in group = {};
+  group.sin_family = AF_INET;
+  group.sin_port = htons(MDNS_PORT);
+  inet_pton(AF_INET, MDNS_GROUP, &group.sin_addr);
+
+  timespec last = {};
+  uint8_t buf[1500];
+
+  while (!stop.load()) {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long sinceMs = (now.tv_sec - last.tv_sec) * 1000 + (now.tv_nsec - last.tv_nsec) / 1000000;
+    if (last.tv_sec == 0 || sinceMs >= intervalMs) {
+      sendto(fd, query.data(), query.size(), 0, (sockaddr*)&group, sizeof(group));
+      last = now;
+    }
+
+    ssize_t n = recv(fd, buf, sizeof(buf), 0);
+    if (n > 0) mdnsParseResponse(buf, (size_t)n, found);
+  }
+
+  close(fd);
+  return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <functional>
+#include <string>
+
+// ---------------------------
+// mDNS BROWSER (_aeroduel._tcp)
+// ---------------------------
+// Minimal DNS-SD client for the records discovery.cpp publishes. Queries
+// go out as legacy unicast (from an ephemeral port), so responders answer
+// straight back to us and nothing has to share port 5353 with the host's
+// own mDNS daemon. The PTR answer comes with SRV, TXT and A records in
+// the additional section; a plane is reported once all four are known.
+
+struct DiscoveredPlane {
+  uint16_t    id;
+  std::string name;
+  std::string ip;
+  uint16_t    port;
+};
+
+typedef std::function<void(const DiscoveredPlane&)> DiscoveryCallback;
+
+// Re-queries every intervalMs until stop. Returns false if the socket
+// could not be set up.
+bool mdnsBrowse(const std::atomic<bool>& stop, int intervalMs, const DiscoveryCallback& found);
+
+// Parses one response packet; exposed for testing with canned packets.
+void mdnsParseResponse(const uint8_t* pkt, size_t len, const DiscoveryCallback& found);
@@ -0,0 +1,312 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <random>
+
+#include "plane_link.h"
+#include "ws_proto.h"
+
+#define WAKE_TAG 0xFFFFFFFFu
+#define READ_CHUNK 4096
+
+int64_t monoNs() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// "HIT" from AUTH_ENABLED=0 planes, else "HIT <seq> <timeMs> [tag]".
+// seq is 0 for the bare form. The tag is not checked: the scoreboard
+// holds no keys.
+static bool parseHitFrame(const uint8_t* p, size_t len, uint32_t& seq) {
+  if (len < 3 || memcmp(p, "HIT", 3) != 0) return false;
+  seq = 0;
+  if (len == 3) return true;
+
+  size_t i = 3;
+  uint32_t field[2];
+  for (uint32_t& v : field) {
+    if (i >= len || p[i++] != ' ') return false;
+    size_t start = i;
+    uint64_t n = 0;
+    while (i < len && p[i] >= '0' && p[i] <= '9' && i - start < 10) n = n * 10 + (p[i++] - '0');
+    if (i == start || n > UINT32_MAX) return false;
+    v = (uint32_t)n;
+  }
+  if (i < len && p[i] != ' ') return false;
+  seq = field[0];
+  return seq != 0;
+}
+
+static uint32_t maskKey() {
+  static thread_local std::mt19937 rng(std::random_device{}());
+  return rng() | 1;   // never 0: 0 means "unmasked" to wsAppendFrame
+}
+
+LinkWorker::LinkWorker(Scoreboard& board, MatchControl& match)
+  : board(board), match(match) {
+  epfd = epoll_create1(EPOLL_CLOEXEC);
+  wakefd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  epoll_event ev = {};
+  ev.events = EPOLLIN;
+  ev.data.u32 = WAKE_TAG;
+  epoll_ctl(epfd, EPOLL_CTL_ADD, wakefd, &ev);
+}
+
+LinkWorker::~LinkWorker() {
+  for (Conn& c : conns) if (c.fd >= 0) close(c.fd);
+  close(wakefd);
+  close(epfd);
+}
+
+bool LinkWorker::addPlane(int slot) {
+  if (!adds.push(slot)) return false;
+  wake();
+  return true;
+}
+
+void LinkWorker::wake() {
+  uint64_t one = 1;
+  ssize_t r = write(wakefd, &one, sizeof(one));
+  (void)r;
+}
+
+// ---------------------------
+// CONNECTION LIFECYCLE
+// ---------------------------
+void LinkWorker::startConnect(Conn& c, int64_t nowNs) {
+  const PlaneSlot& s = board.slot(c.slot);
+  sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(s.port);
+  if (inet_pton(AF_INET, s.host, &addr.sin_addr) != 1) {
+    c.retryAtNs = INT64_MAX;   // bad address, never retry
+    connectFailures++;
+    return;
+  }
+
+  c.fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  int one = 1;
+  setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+  if (connect(c.fd, (sockaddr*)&addr, sizeof(addr)) != 0 && errno != EINPROGRESS) {
+    drop(c, nowNs);
+    return;
+  }
+
+  c.state = CONNECTING;
+  c.in.clear();
+  c.out.clear();
+  c.seq = 0;
+
+  epoll_event ev = {};
+  ev.events = EPOLLIN | EPOLLOUT;
+  ev.data.u32 = (uint32_t)(&c - conns.data());
+  epoll_ctl(epfd, EPOLL_CTL_ADD, c.fd, &ev);
+  c.wantWrite = true;
+}
+
+void LinkWorker::drop(Conn& c, int64_t nowNs) {
+  if (c.fd >= 0) close(c.fd);   // also leaves the epoll set
+  c.fd = -1;
+
+  PlaneSlot& s = board.slot(c.slot);
+  if (c.state == OPEN) {
+    s.connected.store(false, std::memory_order_relaxed);
+    s.disconnects.fetch_add(1, std::memory_order_relaxed);
+    open--;
+    c.failures = 0;
+  } else {
+    connectFailures++;
+    c.failures++;
+  }
+
+  int64_t backoffMs = std::min<int64_t>(LINK_RECONNECT_MAX_MS,
+                                        (int64_t)LINK_RECONNECT_MIN_MS << std::min<uint32_t>(c.failures, 5));
+  c.state = IDLE;
+  c.retryAtNs = nowNs + backoffMs * 1000000;
+}
+
+void LinkWorker::updateInterest(Conn& c) {
+  bool want = !c.out.empty() || c.state == CONNECTING;
+  if (want == c.wantWrite) return;
+  c.wantWrite = want;
+
+  epoll_event ev = {};
+  ev.events = want ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+  ev.data.u32 = (uint32_t)(&c - conns.data());
+  epoll_ctl(epfd, EPOLL_CTL_MOD, c.fd, &ev);
+}
+
+void LinkWorker::flush(Conn& c) {
+  while (!c.out.empty()) {
+    ssize_t n = ::send(c.fd, c.out.data(), c.out.size(), MSG_NOSIGNAL);
+    if (n <= 0) break;
+    c.out.erase(0, (size_t)n);
+  }
+  updateInterest(c);
+}
+
+void LinkWorker::send(Conn& c, uint8_t opcode, const char* text) {
+  wsAppendFrame(c.out, opcode, text, strlen(text), maskKey());
+  flush(c);
+}
+
+void LinkWorker::onOpen(Conn& c) {
+  c.state = OPEN;
+  PlaneSlot& s = board.slot(c.slot);
+  s.connected.store(true, std::memory_order_relaxed);
+  s.connects.fetch_add(1, std::memory_order_relaxed);
+  open++;
+
+  // A plane that (re)joins mid-match is told so, like the phone would.
+  if (match.active.load()) send(c, WS_OP_TEXT, "MATCH_START");
+}
+
+void LinkWorker::onFrames(Conn& c, int64_t nowNs) {
+  size_t pos = 0;
+  WsFrame f;
+  long n;
+
+  while ((n = wsParseFrame((uint8_t*)&c.in[pos], c.in.size() - pos, f)) > 0) {
+    pos += (size_t)n;
+    framesIn++;
+
+    uint32_t seq;
+    if (f.opcode == WS_OP_TEXT && parseHitFrame(f.payload, f.len, seq)) {
+      seq = seq ? seq : c.seq + 1;
+      c.seq = seq;
+      board.hit(c.slot, nowNs);
+      TimelineEvent e = { nowNs, sentLookup ? sentLookup(c.slot, seq) : 0, seq,
+                          (uint16_t)c.slot };
+      if (!queue.push(e)) queueFull++;
+    } else if (f.opcode == WS_OP_PING) {
+      wsAppendFrame(c.out, WS_OP_PONG, f.payload, f.len, maskKey());
+      flush(c);
+    } else if (f.opcode == WS_OP_CLOSE) {
+      drop(c, nowNs);
+      return;
+    }
+  }
+
+  if (n < 0) {
+    drop(c, nowNs);
+    return;
+  }
+  c.in.erase(0, pos);
+}
+
+void LinkWorker::onEvent(Conn& c, uint32_t events, int64_t nowNs) {
+  if (c.state == CONNECTING && (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))) {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    getsockopt(c.fd, SOL_SOCKET, SO_ERROR, &err, &len);
+    if (err != 0) {
+      drop(c, nowNs);
+      return;
+    }
+
+    const PlaneSlot& s = board.slot(c.slot);
+    c.key = wsNewKey();
+    c.out = "GET /ws HTTP/1.1\r\nHost: " + std::string(s.host) + ":" + std::to_string(s.port) +
+            "\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Key: " + c.key +
+            "\r\nSec-WebSocket-Version: 13\r\n\r\n";
+    c.state = HANDSHAKE;
+    flush(c);
+    return;
+  }
+
+  if (events & EPOLLOUT) flush(c);
+
+  if (events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+    char buf[READ_CHUNK];
+    ssize_t n;
+    while ((n = recv(c.fd, buf, sizeof(buf), 0)) > 0) {
+      c.in.append(buf, (size_t)n);
+      bytesIn += (uint64_t)n;
+    }
+    if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+      drop(c, nowNs);
+      return;
+    }
+
+    if (c.state == HANDSHAKE) {
+      size_t end = httpHeaderEnd(c.in);
+      if (!end) return;
+      std::string head = c.in.substr(0, end);
+      if (head.compare(0, 12, "HTTP/1.1 101") != 0 ||
+          httpHeader(head, "Sec-WebSocket-Accept") != wsAcceptKey(c.key)) {
+        drop(c, nowNs);
+        return;
+      }
+      c.in.erase(0, end);
+      onOpen(c);
+      if (c.fd < 0) return;
+    }
+
+    if (c.state == OPEN) onFrames(c, nowNs);
+  }
+}
+
+void LinkWorker::broadcastMatch(bool active) {
+  for (Conn& c : conns) {
+    if (c.state == OPEN) send(c, WS_OP_TEXT, active ? "MATCH_START" : "MATCH_END");
+  }
+}
+
+// ---------------------------
+// EVENT LOOP
+// ---------------------------
+void LinkWorker::run(const std::atomic<bool>& stop) {
+  epoll_event events[256];
+
+  while (!stop.load()) {
+    int64_t now = monoNs();
+
+    // Conn addresses are epoll tags (indices), so only grow between waits.
+    int slot;
+    while (adds.pop(slot)) {
+      conns.emplace_back();
+      conns.back().slot = slot;
+      conns.back().retryAtNs = now;
+    }
+
+    uint32_t gen = match.gen.load();
+    if (gen != seenGen) {
+      seenGen = gen;
+      broadcastMatch(match.active.load());
+    }
+
+    int64_t nextRetry = now + 100000000;   // wake at least every 100 ms
+    for (Conn& c : conns) {
+      if (c.state != IDLE) continue;
+      if (c.retryAtNs <= now) startConnect(c, now);
+      else nextRetry = std::min(nextRetry, c.retryAtNs);
+    }
+
+    int timeoutMs = (int)std::max<int64_t>(0, (nextRetry - now) / 1000000);
+    int n = epoll_wait(epfd, events, 256, timeoutMs);
+    now = monoNs();
+
+    for (int i = 0; i < n; i++) {
+      uint32_t tag = events[i].data.u32;
+      if (tag == WAKE_TAG) {
+        uint64_t v;
+        ssize_t r = read(wakefd, &v, sizeof(v));
+        (void)r;
+        continue;
+      }
+      Conn& c = conns[tag];
+      if (c.fd >= 0) onEvent(c, events[i].events, now);
+    }
+  }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "scoreboard.h"
+#include "spsc_queue.h"
+
+// ---------------------------
+// PLANE LINK WORKER
+// ---------------------------
+// One thread, one epoll set, a shard of the fleet. For every plane it
+// keeps a WebSocket client to ws://host:port/ws open (reconnecting with
+// backoff), answers pings, relays MATCH_START / MATCH_END like the phone
+// does, and turns every hit frame ("HIT <seq> <timeMs> [tag]", or a bare
+// "HIT") into a scoreboard bump plus a timeline event on its own SPSC
+// queue.
+//
+// MATCH_START / MATCH_END go out unsigned, so only planes built with
+// AUTH_ENABLED=0 follow them; signed planes reject them (phone_auth.h).
+
+#define LINK_ADD_QUEUE SCOREBOARD_MAX_PLANES
+#define LINK_RECONNECT_MIN_MS 250
+#define LINK_RECONNECT_MAX_MS 5000
+
+// Shared referee state; workers notice gen changes and tell their planes.
+struct MatchControl {
+  std::atomic<bool>     active{false};
+  std::atomic<uint32_t> gen{0};
+};
+
+// Simulated planes know when each hit left; real ones return 0.
+typedef int64_t (*SentLookup)(int plane, uint32_t seq);
+
+class LinkWorker {
+public:
+  LinkWorker(Scoreboard& board, MatchControl& match);
+  ~LinkWorker();
+
+  // From one producer thread (discovery) at a time.
+  bool addPlane(int slot);
+  void wake();
+
+  void run(const std::atomic<bool>& stop);
+
+  TimelineQueue queue;
+  SentLookup    sentLookup = nullptr;
+
+  std::atomic<uint64_t> framesIn{0};
+  std::atomic<uint64_t> bytesIn{0};
+  std::atomic<uint64_t> connectFailures{0};
+  std::atomic<uint64_t> queueFull{0};
+  std::atomic<uint32_t> open{0};
+
+private:
+  enum State { IDLE, CONNECTING, HANDSHAKE, OPEN };
+
+  struct Conn {
+    int         slot;
+    int         fd = -1;
+    State       state = IDLE;
+    std::string key;
+    std::string in;
+    std::string out;
+    uint32_t    seq = 0;
+    uint32_t    failures = 0;
+    int64_t     retryAtNs = 0;
+    bool        wantWrite = false;
+  };
+
+  void startConnect(Conn& c, int64_t nowNs);
+  void onEvent(Conn& c, uint32_t events, int64_t nowNs);
+  void onOpen(Conn& c);
+  void onFrames(Conn& c, int64_t nowNs);
+  void drop(Conn& c, int64_t nowNs);
+  void send(Conn& c, uint8_t opcode, const char* text);
+  void flush(Conn& c);
+  void updateInterest(Conn& c);
+  void broadcastMatch(bool active);
+
+  Scoreboard&   board;
+  MatchControl& match;
+  int           epfd;
+  int           wakefd;
+  uint32_t      seenGen = 0;
+  std::vector<Conn> conns;
+  SpscQueue<int, LINK_ADD_QUEUE> adds;
+};
+
+int64_t monoNs();
@@ -0,0 +1,145 @@
+#include <string.h>
+#include <algorithm>
+#include "scoreboard.h"
+
+// ---------------------------
+// SCOREBOARD
+// ---------------------------
+int Scoreboard::findPlane(uint16_t id) const {
+  size_t n = size();
+  for (size_t i = 0; i < n; i++) {
+    if (slots[i].ready.load(std::memory_order_acquire) && slots[i].id == id) return (int)i;
+  }
+  return -1;
+}
+
+int Scoreboard::addPlane(uint16_t id, const char* name, const char* host, uint16_t port) {
+  int existing = findPlane(id);
+  if (existing >= 0) return existing;
+
+  size_t i = count.load(std::memory_order_relaxed);
+  if (i >= SCOREBOARD_MAX_PLANES) return -1;
+
+  PlaneSlot& s = slots[i];
+  s.id = id;
+  strncpy(s.name, name, sizeof(s.name) - 1);
+  strncpy(s.host, host, sizeof(s.host) - 1);
+  s.port = port;
+  s.ready.store(true, std::memory_order_release);
+  count.store(i + 1, std::memory_order_release);
+  return (int)i;
+}
+
+void Scoreboard::hit(int plane, int64_t nowNs) {
+  slots[plane].hits.fetch_add(1, std::memory_order_relaxed);
+  slots[plane].lastHitNs.store(nowNs, std::memory_order_relaxed);
+  totalHits.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Scoreboard::resetHits() {
+  size_t n = size();
+  for (size_t i = 0; i < n; i++) {
+    slots[i].hits.store(0, std::memory_order_relaxed);
+    slots[i].lastHitNs.store(0, std::memory_order_relaxed);
+  }
+  totalHits.store(0, std::memory_order_relaxed);
+}
+
+void Scoreboard::standings(std::vector<Standing>& out) const {
+  out.clear();
+  size_t n = size();
+  for (size_t i = 0; i < n; i++) {
+    const PlaneSlot& s = slots[i];
+    if (!s.ready.load(std::memory_order_acquire)) continue;
+    out.push_back({ s.id, s.name, s.hits.load(std::memory_order_relaxed),
+                    s.connected.load(std::memory_order_relaxed),
+                    s.connects.load(std::memory_order_relaxed),
+                    s.disconnects.load(std::memory_order_relaxed),
+                    s.lastHitNs.load(std::memory_order_relaxed) });
+  }
+  std::sort(out.begin(), out.end(), [](const Standing& a, const Standing& b) {
+    return a.hits != b.hits ? a.hits > b.hits : a.id < b.id;
+  });
+}
+
+// ---------------------------
+// LAG HISTOGRAM
+// ---------------------------
+static size_t lagBucket(uint64_t us) {
+  if (us < LAG_SUB_BUCKETS) return (size_t)us;
+  int top = 63 - __builtin_clzll(us);                 // >= LAG_SUB_BITS
+  size_t octave = (size_t)(top - LAG_SUB_BITS + 1);
+  if (octave >= LAG_OCTAVES) return LAG_BUCKETS - 1;
+  size_t sub = (size_t)(us >> (top - LAG_SUB_BITS)) & (LAG_SUB_BUCKETS - 1);
+  return octave * LAG_SUB_BUCKETS + sub;
+}
+
+static int64_t lagBucketLowUs(size_t b) {
+  size_t octave = b / LAG_SUB_BUCKETS, sub = b % LAG_SUB_BUCKETS;
+  if (octave == 0) return (int64_t)sub;
+  return (int64_t)((LAG_SUB_BUCKETS + sub) << (octave - 1));
+}
+
+void LagHistogram::record(int64_t ns) {
+  uint64_t us = ns > 0 ? (uint64_t)ns / 1000 : 0;
+  counts[lagBucket(us)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LagHistogram::snapshot(LagSnapshot& out) const {
+  out.total = 0;
+  for (size_t i = 0; i < LAG_BUCKETS; i++) {
+    out.counts[i] = counts[i].load(std::memory_order_relaxed);
+    out.total += out.counts[i];
+  }
+}
+
+int64_t LagSnapshot::percentileUs(double p) const {
+  if (total == 0) return -1;
+  uint64_t rank = (uint64_t)(p * (double)(total - 1) + 0.5);
+  uint64_t seen = 0;
+  for (size_t i = 0; i < LAG_BUCKETS; i++) {
+    seen += counts[i];
+    if (seen > rank) return lagBucketLowUs(i);
+  }
+  return lagBucketLowUs(LAG_BUCKETS - 1);
+}
+
+// ---------------------------
+// TIMELINE
+// ---------------------------
+static bool later(const TimelineEvent& a, const TimelineEvent& b) {
+  return a.arrivalNs > b.arrivalNs;
+}
+
+Timeline::Timeline(size_t capacity, int64_t reorderNs) : reorderNs(reorderNs), events(capacity) {}
+
+size_t Timeline::mergeStep(int64_t nowNs, bool flush) {
+  TimelineEvent e;
+  for (TimelineQueue* q : queues) {
+    while (q->pop(e)) {
+      heap.push_back(e);
+      std::push_heap(heap.begin(), heap.end(), later);
+    }
+  }
+
+  size_t n = 0;
+  size_t pub = published.load(std::memory_order_relaxed);
+  while (!heap.empty() && (flush || heap.front().arrivalNs <= nowNs - reorderNs)) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    e = heap.back();
+    heap.pop_back();
+
+    if (e.arrivalNs < lastPublishedNs) outOfOrder++;
+    lastPublishedNs = std::max(lastPublishedNs, e.arrivalNs);
+
+    if (pub == events.size()) {
+      overflow++;
+      continue;
+    }
+    events[pub++] = e;
+    publishLag.record(nowNs - e.arrivalNs);
+    n++;
+  }
+  published.store(pub, std::memory_order_release);
+  return n;
+}
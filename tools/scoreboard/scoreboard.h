@@ -0,0 +1,144 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <vector>
+
+#include "spsc_queue.h"
+
+// ---------------------------
+// SCOREBOARD (lock-free)
+// ---------------------------
+// One slot per plane, appended at runtime as planes are discovered.
+// Link workers bump counters with relaxed atomics; HTTP readers take
+// snapshots without stopping anyone. A slot becomes visible to readers
+// only after it is fully written (ready, release / acquire).
+
+#define SCOREBOARD_MAX_PLANES 1024
+#define PLANE_NAME_MAX 32
+
+struct PlaneSlot {
+  std::atomic<bool>     ready{false};
+  uint16_t              id = 0;
+  char                  name[PLANE_NAME_MAX] = {};
+  char                  host[64] = {};
+  uint16_t              port = 0;
+
+  std::atomic<uint32_t> hits{0};
+  std::atomic<bool>     connected{false};
+  std::atomic<uint32_t> connects{0};
+  std::atomic<uint32_t> disconnects{0};
+  std::atomic<int64_t>  lastHitNs{0};
+};
+
+struct Standing {
+  uint16_t    id;
+  const char* name;
+  uint32_t    hits;
+  bool        connected;
+  uint32_t    connects;
+  uint32_t    disconnects;
+  int64_t     lastHitNs;
+};
+
+class Scoreboard {
+public:
+  // Single writer (the thread that discovers planes). Returns the slot
+  // index, the existing one if id is already known, or -1 when full.
+  int addPlane(uint16_t id, const char* name, const char* host, uint16_t port);
+
+  int findPlane(uint16_t id) const;
+  size_t size() const { return count.load(std::memory_order_acquire); }
+  PlaneSlot& slot(int i) { return slots[i]; }
+  const PlaneSlot& slot(int i) const { return slots[i]; }
+
+  void hit(int plane, int64_t nowNs);
+  void resetHits();
+
+  // Sorted by hits (desc), then id.
+  void standings(std::vector<Standing>& out) const;
+
+  std::atomic<uint64_t> totalHits{0};
+
+private:
+  PlaneSlot slots[SCOREBOARD_MAX_PLANES];
+  std::atomic<size_t> count{0};
+};
+
+// ---------------------------
+// TIMELINE
+// ---------------------------
+// Every worker pushes its hits, in its own arrival order, into its own
+// SPSC queue. The merger pops all queues into a min-heap and publishes
+// an event only once it is older than the reorder window, so the
+// timeline is globally time-ordered even though workers run freely.
+// Published events go into a preallocated array with an atomic count:
+// one writer (merger), any number of lock-free readers.
+
+struct TimelineEvent {
+  int64_t  arrivalNs;   // when the worker read the frame
+  int64_t  sentNs;      // simulated planes only, else 0
+  uint32_t planeSeq;    // hits on this connection
+  uint16_t plane;       // scoreboard slot
+};
+
+#define TIMELINE_QUEUE 4096
+
+// ---------------------------
+// LAG HISTOGRAM
+// ---------------------------
+// Fixed-size log-linear histogram of microseconds: each power of two is
+// split into LAG_SUB_BUCKETS, so a percentile is within 1/8 of the true
+// value (exact below 8 us). One writer bumps buckets with relaxed
+// atomics; any thread may take a snapshot at any time.
+
+#define LAG_SUB_BITS     3
+#define LAG_SUB_BUCKETS  (1 << LAG_SUB_BITS)
+#define LAG_OCTAVES      32
+#define LAG_BUCKETS      (LAG_OCTAVES * LAG_SUB_BUCKETS)
+
+struct LagSnapshot {
+  uint64_t counts[LAG_BUCKETS];
+  uint64_t total;
+
+  // Lower edge of the bucket holding percentile p (0..1), in us; -1 if empty.
+  int64_t percentileUs(double p) const;
+};
+
+class LagHistogram {
+public:
+  void record(int64_t ns);
+  void snapshot(LagSnapshot& out) const;
+
+private:
+  std::atomic<uint64_t> counts[LAG_BUCKETS] = {};
+};
+
+typedef SpscQueue<TimelineEvent, TIMELINE_QUEUE> TimelineQueue;
+
+class Timeline {
+public:
+  Timeline(size_t capacity, int64_t reorderNs);
+
+  void addQueue(TimelineQueue* q) { queues.push_back(q); }
+
+  // Merger thread: drains queues, publishes everything older than
+  // nowNs - reorderNs (or everything when flush). Returns events published.
+  size_t mergeStep(int64_t nowNs, bool flush);
+
+  size_t size() const { return published.load(std::memory_order_acquire); }
+  const TimelineEvent& at(size_t i) const { return events[i]; }
+
+  int64_t  reorderNs;
+  uint64_t outOfOrder = 0;   // arrived older than an already published event
+  uint64_t overflow = 0;     // timeline full, event dropped
+  LagHistogram publishLag;   // publish - arrival; written by the merger
+
+private:
+  std::vector<TimelineQueue*> queues;
+  std::vector<TimelineEvent>  heap;
+  std::vector<TimelineEvent>  events;
+  std::atomic<size_t>         published{0};
+  int64_t                     lastPublishedNs = 0;
+};
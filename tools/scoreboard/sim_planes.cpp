@@ -0,0 +1,209 @@
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "commands.h"
+#include "plane_link.h"
+#include "sim_planes.h"
+#include "ws_proto.h"
+
+struct SimConn {
+  int         plane;
+  int         fd;
+  bool        listener = false;
+  bool        upgraded = false;
+  bool        inMatch = false;
+  uint32_t    seq = 0;
+  int64_t     nextHitNs = 0;
+  std::string in;
+  std::string out;
+};
+
+bool SimFleet::start(const SimOptions& opts, const std::atomic<bool>& stop) {
+  o = opts;
+  sent.reset(new std::atomic<int64_t>[(size_t)o.planes * SIM_SENT_RING]());
+
+  for (int i = 0; i < o.planes; i++) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in a = {};
+    a.sin_family = AF_INET;
+    a.sin_port = htons((uint16_t)(o.basePort + i));
+    a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(fd, (sockaddr*)&a, sizeof(a)) != 0 || listen(fd, 16) != 0) {
+      fprintf(stderr, "sim plane %d: port %d: %s\n", i + 1, o.basePort + i, strerror(errno));
+      return false;
+    }
+    listeners.push_back(fd);
+  }
+
+  for (int t = 0; t < o.threads; t++) {
+    threads.emplace_back([this, t, &stop] { runThread(t, stop); });
+  }
+  return true;
+}
+
+void SimFleet::join() {
+  for (std::thread& t : threads) t.join();
+  for (int fd : listeners) close(fd);
+}
+
+int64_t SimFleet::sentNs(int plane, uint32_t seq) const {
+  if (plane < 0 || plane >= o.planes) return 0;
+  return sent[(size_t)plane * SIM_SENT_RING + (seq % SIM_SENT_RING)].load(std::memory_order_relaxed);
+}
+
+// ---------------------------
+// PLANE THREAD
+// ---------------------------
+void SimFleet::runThread(int index, const std::atomic<bool>& stop) {
+  int epfd = epoll_create1(EPOLL_CLOEXEC);
+  std::mt19937 rng(o.seed + (uint32_t)index);
+  std::exponential_distribution<double> gap(o.hitsPerSec > 0 ? o.hitsPerSec : 1.0);
+  std::vector<SimConn*> conns;
+  std::vector<SimConn> ports;
+
+  auto nextGap = [&]() { return (int64_t)(gap(rng) * 1e9); };
+
+  for (int i = index; i < o.planes; i += o.threads) {
+    ports.emplace_back();
+    ports.back().plane = i;
+    ports.back().fd = listeners[i];
+    ports.back().listener = true;
+  }
+  for (SimConn& p : ports) {
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.ptr = &p;
+    epoll_ctl(epfd, EPOLL_CTL_ADD, p.fd, &ev);
+  }
+
+  auto closeConn = [&](SimConn* c) {
+    close(c->fd);
+    conns.erase(std::find(conns.begin(), conns.end(), c));
+    delete c;
+  };
+
+  auto flush = [&](SimConn* c) {
+    while (!c->out.empty()) {
+      ssize_t n = send(c->fd, c->out.data(), c->out.size(), MSG_NOSIGNAL);
+      if (n <= 0) break;
+      c->out.erase(0, (size_t)n);
+    }
+  };
+
+  epoll_event events[128];
+  while (!stop.load()) {
+    int64_t now = monoNs();
+
+    // Hits due now.
+    int64_t next = now + 50000000;
+    for (SimConn* c : conns) {
+      if (!c->inMatch || o.hitsPerSec <= 0) continue;
+      while (c->nextHitNs <= now) {
+        uint32_t seq = ++c->seq;
+        int64_t at = monoNs();
+        sent[(size_t)c->plane * SIM_SENT_RING + (seq % SIM_SENT_RING)].store(at, std::memory_order_relaxed);
+        char hit[32];
+        int len = snprintf(hit, sizeof(hit), "HIT %u %u", seq, (uint32_t)(at / 1000000));
+        wsAppendFrame(c->out, WS_OP_TEXT, hit, (size_t)len, 0);
+        hitsSent++;
+        c->nextHitNs += nextGap();
+      }
+      flush(c);
+      next = std::min(next, c->nextHitNs);
+    }
+
+    int timeoutMs = (int)std::max<int64_t>(0, (next - now + 999999) / 1000000);
+    int n = epoll_wait(epfd, events, 128, timeoutMs);
+    now = monoNs();
+
+    for (int i = 0; i < n; i++) {
+      SimConn* c = (SimConn*)events[i].data.ptr;
+
+      if (c->listener) {
+        int fd;
+        while ((fd = accept4(c->fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+          int one = 1;
+          setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+          SimConn* nc = new SimConn();
+          nc->plane = c->plane;
+          nc->fd = fd;
+          conns.push_back(nc);
+
+          epoll_event ev = {};
+          ev.events = EPOLLIN;
+          ev.data.ptr = nc;
+          epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev);
+        }
+        continue;
+      }
+
+      char buf[2048];
+      ssize_t r;
+      while ((r = recv(c->fd, buf, sizeof(buf), 0)) > 0) c->in.append(buf, (size_t)r);
+      if (r == 0 || (r < 0 && errno != EAGAIN)) {
+        closeConn(c);
+        continue;
+      }
+
+      if (!c->upgraded) {
+        size_t end = httpHeaderEnd(c->in);
+        if (!end) continue;
+        std::string head = c->in.substr(0, end);
+        std::string key = httpHeader(head, "Sec-WebSocket-Key");
+        if (head.compare(0, 8, "GET /ws ") != 0 || key.empty()) {
+          c->out = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+          flush(c);
+          closeConn(c);
+          continue;
+        }
+        c->out = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                 "Connection: Upgrade\r\nSec-WebSocket-Accept: " + wsAcceptKey(key) + "\r\n\r\n";
+        c->in.erase(0, end);
+        c->upgraded = true;
+        flush(c);
+      }
+
+      size_t pos = 0;
+      WsFrame f;
+      long fl;
+      bool closed = false;
+      while ((fl = wsParseFrame((uint8_t*)&c->in[pos], c->in.size() - pos, f)) > 0) {
+        pos += (size_t)fl;
+        if (f.opcode == WS_OP_TEXT) {
+          PhoneCommand cmd = parseCommand((const char*)f.payload, f.len);
+          if (cmd == CMD_MATCH_START && !c->inMatch) {
+            c->inMatch = true;
+            c->nextHitNs = now + nextGap();
+          } else if (cmd == CMD_MATCH_END) {
+            c->inMatch = false;
+          }
+        } else if (f.opcode == WS_OP_CLOSE) {
+          closed = true;
+          break;
+        }
+      }
+      if (closed || fl < 0) {
+        closeConn(c);
+        continue;
+      }
+      c->in.erase(0, pos);
+    }
+  }
+
+  while (!conns.empty()) closeConn(conns.back());
+  close(epfd);
+}
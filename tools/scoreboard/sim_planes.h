@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ---------------------------
+// SIMULATED PLANES
+// ---------------------------
+// Stand-ins for the firmware's /ws endpoint: plane i listens on
+// 127.0.0.1:basePort+i, accepts the WebSocket upgrade, obeys
+// MATCH_START / MATCH_END (core commands.h, same parser as the plane) and
+// sends "HIT <seq> <timeMs>" frames (a signed plane's format, without the
+// tag) as a Poisson process while a match runs. Send times are kept per
+// (plane, seq) so the scoreboard can report end-to-end latency without
+// changing the wire protocol.
+
+#define SIM_SENT_RING 4096
+
+struct SimOptions {
+  int      planes     = 0;
+  uint16_t basePort   = 47200;
+  double   hitsPerSec = 2.0;    // per plane, during a match
+  int      threads    = 1;
+  uint32_t seed       = 1;
+};
+
+class SimFleet {
+public:
+  bool start(const SimOptions& o, const std::atomic<bool>& stop);
+  void join();
+
+  // When hit seq (1-based, per connection, as sent) of plane left, or 0.
+  int64_t sentNs(int plane, uint32_t seq) const;
+
+  std::atomic<uint64_t> hitsSent{0};
+
+private:
+  void runThread(int index, const std::atomic<bool>& stop);
+
+  SimOptions o;
+  std::vector<int> listeners;
+  std::unique_ptr<std::atomic<int64_t>[]> sent;
+  std::vector<std::thread> threads;
+};
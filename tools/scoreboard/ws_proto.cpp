@@ -0,0 +1,165 @@
+#include <string.h>
+#include <random>
+#include "ws_proto.h"
+
+// ---------------------------
+// SHA-1 (handshake only)
+// ---------------------------
+static uint32_t rol(uint32_t v, int n) {
+  return (v << n) | (v >> (32 - n));
+}
+
+static void sha1Block(uint32_t h[5], const uint8_t* p) {
+  uint32_t w[80];
+  for (int i = 0; i < 16; i++) {
+    w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 |
+           (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+  }
+  for (int i = 16; i < 80; i++) w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+  for (int i = 0; i < 80; i++) {
+    uint32_t f, k;
+    if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+    else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+    else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+    else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+    uint32_t t = rol(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = rol(b, 30);
+    b = a;
+    a = t;
+  }
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+}
+
+void sha1(const uint8_t* data, size_t len, uint8_t out[20]) {
+  uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+  size_t full = len & ~(size_t)63;
+  for (size_t i = 0; i < full; i += 64) sha1Block(h, data + i);
+
+  uint8_t tail[128] = {};
+  size_t rest = len - full;
+  memcpy(tail, data + full, rest);
+  tail[rest] = 0x80;
+  size_t tailLen = (rest < 56) ? 64 : 128;
+  uint64_t bits = (uint64_t)len * 8;
+  for (int i = 0; i < 8; i++) tail[tailLen - 1 - i] = (uint8_t)(bits >> (8 * i));
+  for (size_t i = 0; i < tailLen; i += 64) sha1Block(h, tail + i);
+
+  for (int i = 0; i < 5; i++) {
+    out[4 * i]     = (uint8_t)(h[i] >> 24);
+    out[4 * i + 1] = (uint8_t)(h[i] >> 16);
+    out[4 * i + 2] = (uint8_t)(h[i] >> 8);
+    out[4 * i + 3] = (uint8_t)h[i];
+  }
+}
+
+std::string base64(const uint8_t* data, size_t len) {
+  static const char tbl[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  std::string out;
+  for (size_t i = 0; i < len; i += 3) {
+    uint32_t v = (uint32_t)data[i] << 16;
+    if (i + 1 < len) v |= (uint32_t)data[i + 1] << 8;
+    if (i + 2 < len) v |= data[i + 2];
+    out += tbl[(v >> 18) & 63];
+    out += tbl[(v >> 12) & 63];
+    out += (i + 1 < len) ? tbl[(v >> 6) & 63] : '=';
+    out += (i + 2 < len) ? tbl[v & 63] : '=';
+  }
+  return out;
+}
+
+// ---------------------------
+// HANDSHAKE
+// ---------------------------
+std::string wsAcceptKey(const std::string& key) {
+  std::string s = key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+  uint8_t digest[20];
+  sha1((const uint8_t*)s.data(), s.size(), digest);
+  return base64(digest, sizeof(digest));
+}
+
+std::string wsNewKey() {
+  static thread_local std::mt19937 rng(std::random_device{}());
+  uint8_t raw[16];
+  for (uint8_t& b : raw) b = (uint8_t)rng();
+  return base64(raw, sizeof(raw));
+}
+
+size_t httpHeaderEnd(const std::string& buf) {
+  size_t p = buf.find("\r\n\r\n");
+  return p == std::string::npos ? 0 : p + 4;
+}
+
+std::string httpHeader(const std::string& head, const char* name) {
+  size_t n = strlen(name);
+  size_t pos = 0;
+  while ((pos = head.find("\r\n", pos)) != std::string::npos) {
+    pos += 2;
+    if (head.size() - pos > n && strncasecmp(head.c_str() + pos, name, n) == 0 &&
+        head[pos + n] == ':') {
+      size_t v = pos + n + 1;
+      while (v < head.size() && head[v] == ' ') v++;
+      size_t e = head.find("\r\n", v);
+      return head.substr(v, e == std::string::npos ? std::string::npos : e - v);
+    }
+  }
+  return std::string();
+}
+
+// ---------------------------
+// FRAMES
+// ---------------------------
+void wsAppendFrame(std::string& out, uint8_t opcode, const void* payload, size_t len,
+                   uint32_t maskKey) {
+  const uint8_t* p = (const uint8_t*)payload;
+  uint8_t maskBit = maskKey ? 0x80 : 0;
+
+  out += (char)(0x80 | opcode);
+  if (len < 126) {
+    out += (char)(maskBit | len);
+  } else {
+    out += (char)(maskBit | 126);
+    out += (char)(len >> 8);
+    out += (char)len;
+  }
+
+  if (!maskKey) {
+    out.append((const char*)p, len);
+    return;
+  }
+
+  uint8_t m[4] = { (uint8_t)(maskKey >> 24), (uint8_t)(maskKey >> 16),
+                   (uint8_t)(maskKey >> 8), (uint8_t)maskKey };
+  out.append((const char*)m, 4);
+  for (size_t i = 0; i < len; i++) out += (char)(p[i] ^ m[i & 3]);
+}
+
+long wsParseFrame(uint8_t* data, size_t len, WsFrame& f) {
+  if (len < 2) return 0;
+
+  f.fin = (data[0] & 0x80) != 0;
+  f.opcode = data[0] & 0x0F;
+  bool masked = (data[1] & 0x80) != 0;
+  size_t plen = data[1] & 0x7F;
+  size_t hdr = 2;
+
+  if (plen == 127) return -1;
+  if (plen == 126) {
+    if (len < 4) return 0;
+    plen = (size_t)data[2] << 8 | data[3];
+    hdr = 4;
+  }
+  if (masked) hdr += 4;
+  if (len < hdr + plen) return 0;
+
+  f.payload = data + hdr;
+  f.len = plen;
+  if (masked) {
+    const uint8_t* m = data + hdr - 4;
+    for (size_t i = 0; i < plen; i++) f.payload[i] ^= m[i & 3];
+  }
+  return (long)(hdr + plen);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// ---------------------------
+// WEBSOCKET WIRE FORMAT (RFC 6455, the subset the planes use)
+// ---------------------------
+// Text / binary / ping / pong / close frames, no extensions, payloads
+// up to 64 KB. Client frames are masked, server frames are not.
+
+#define WS_OP_TEXT   0x1
+#define WS_OP_BINARY 0x2
+#define WS_OP_CLOSE  0x8
+#define WS_OP_PING   0x9
+#define WS_OP_PONG   0xA
+
+#define WS_FRAME_OVERHEAD 8   // 2 header + 2 extended length + 4 mask
+#define WS_PAYLOAD_MAX 65535
+
+void sha1(const uint8_t* data, size_t len, uint8_t out[20]);
+std::string base64(const uint8_t* data, size_t len);
+
+// Sec-WebSocket-Accept for a given Sec-WebSocket-Key.
+std::string wsAcceptKey(const std::string& key);
+
+// Random 16-byte key, base64.
+std::string wsNewKey();
+
+// Appends one frame to out. maskKey != 0 masks it (client side).
+void wsAppendFrame(std::string& out, uint8_t opcode, const void* payload, size_t len,
+                   uint32_t maskKey);
+
+struct WsFrame {
+  uint8_t  opcode;
+  bool     fin;
+  uint8_t* payload;   // unmasked in place, inside the parsed buffer
+  size_t   len;
+};
+
+// Parses one frame at the start of data. Returns the frame's total size,
+// 0 if more bytes are needed, or -1 if the frame is invalid / too big.
+long wsParseFrame(uint8_t* data, size_t len, WsFrame& f);
+
+// Finds "\r\n\r\n"; returns the header length including it, or 0.
+size_t httpHeaderEnd(const std::string& buf);
+
+// Case-insensitive header lookup in a raw HTTP header block.
+std::string httpHeader(const std::string& head, const char* name);
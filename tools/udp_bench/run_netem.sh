@@ -0,0 +1,15 @@
+#!/bin/sh
+# Runs udp_loopback_bench under netem packet loss on lo (needs root).
+#   sudo tools/udp_bench/run_netem.sh [extra bench args]
+# Prints one JSON line per path per loss rate.
+
+BENCH=${BENCH:-.pio/build/udp_bench/program}
+LOSSES=${LOSSES:-"0 1 2 5 10"}
+
+trap 'tc qdisc del dev lo root 2>/dev/null' EXIT
+
+for loss in $LOSSES; do
+  tc qdisc replace dev lo root netem delay 1ms loss "${loss}%"
+  echo "# netem loss ${loss}%" >&2
+  "$BENCH" --json "$@"
+done
@@ -0,0 +1,323 @@
+// ---------------------------
+// UDP vs WEBSOCKET HIT LATENCY BENCH (Linux loopback)
+// ---------------------------
+// Sends the same hit schedule over two paths on 127.0.0.1 and prints the
+// delivery latency distribution of each:
+//
+//   udp : HitPacket datagrams, UDP_HIT_COPIES-style redundancy,
+//         de-duplicated with HitReceiver (the real receiver library)
+//   ws  : "HIT" WebSocket text frames over one TCP_NODELAY connection
+//
+// Packet loss is injected with netem on lo so both paths see the same
+// channel (see run_netem.sh). --drop adds extra application-level loss
+// to the UDP path only, for runs without root.
+//
+//   pio run -e udp_bench
+//   .pio/build/udp_bench/program --hits 2000 --copies 3 --spacing-us 4000
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hit_packet.h"
+
+struct Options {
+  int      hits       = 2000;
+  int      intervalUs = 5000;
+  int      copies     = 3;
+  int      spacingUs  = 4000;
+  double   drop       = 0.0;
+  int      drainMs    = 3000;
+  uint16_t port       = 47100;
+  bool     json       = false;
+};
+
+struct PathResult {
+  const char*          name;
+  int                  sent = 0;
+  int                  delivered = 0;
+  uint32_t             duplicates = 0;
+  std::vector<int64_t> latencyUs;
+};
+
+static int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void sleepUntilNs(int64_t t) {
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+      std::chrono::nanoseconds(t)));
+}
+
+static sockaddr_in loopback(uint16_t port) {
+  sockaddr_in a = {};
+  a.sin_family = AF_INET;
+  a.sin_port = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  return a;
+}
+
+static void setRecvTimeout(int fd, int ms) {
+  timeval tv = { ms / 1000, (ms % 1000) * 1000 };
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+}
+
+// ---------------------------
+// UDP PATH
+// ---------------------------
+static PathResult runUdp(const Options& o) {
+  PathResult r;
+  r.name = "udp";
+
+  int rx = socket(AF_INET, SOCK_DGRAM, 0);
+  int tx = socket(AF_INET, SOCK_DGRAM, 0);
+  sockaddr_in addr = loopback(o.port);
+  if (bind(rx, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    perror("udp bind");
+    exit(1);
+  }
+  setRecvTimeout(rx, 50);
+
+  std::vector<std::atomic<int64_t>> sentAt(o.hits + 1);
+  std::atomic<bool> senderDone(false);
+  HitReceiver receiver;
+
+  std::thread rxThread([&] {
+    int64_t quietSince = 0;
+    uint8_t buf[64];
+    while (true) {
+      ssize_t n = recv(rx, buf, sizeof(buf), 0);
+      int64_t t = nowNs();
+      if (n < 0) {
+        if (!senderDone) continue;
+        if (!quietSince) quietSince = t;
+        if (t - quietSince > (int64_t)o.drainMs * 1000000) break;
+        continue;
+      }
+      quietSince = 0;
+
+      HitPacket pkt;
+      if (!decodeHitPacket(buf, (size_t)n, pkt)) continue;
+      if (pkt.seq == 0 || pkt.seq > (uint32_t)o.hits) continue;
+      if (!receiver.accept(pkt)) continue;
+
+      r.delivered++;
+      r.latencyUs.push_back((t - sentAt[pkt.seq].load()) / 1000);
+      if (r.delivered == o.hits) break;
+    }
+  });
+
+  // Copies of consecutive hits interleave, so walk a merged schedule.
+  struct Send { int64_t at; uint32_t seq; uint8_t copy; };
+  std::vector<Send> schedule;
+  int64_t t0 = nowNs() + 10000000;
+  for (int i = 1; i <= o.hits; i++) {
+    int64_t base = t0 + (int64_t)(i - 1) * o.intervalUs * 1000;
+    for (int c = 0; c < o.copies; c++) {
+      schedule.push_back({ base + (int64_t)c * o.spacingUs * 1000,
+                           (uint32_t)i, (uint8_t)c });
+    }
+  }
+  std::stable_sort(schedule.begin(), schedule.end(),
+                   [](const Send& a, const Send& b) { return a.at < b.at; });
+
+  std::mt19937 rng(12345);
+  std::bernoulli_distribution dropped(o.drop);
+
+  for (const Send& s : schedule) {
+    sleepUntilNs(s.at);
+
+    HitPacket pkt;
+    pkt.type = HIT_PACKET_HIT;
+    pkt.planeId = 1;
+    pkt.bootId = 1;
+    pkt.seq = s.seq;
+    pkt.timeMs = 0;
+    pkt.copy = s.copy;
+    pkt.copies = (uint8_t)o.copies;
+
+    uint8_t buf[HIT_PACKET_SIZE];
+    encodeHitPacket(pkt, buf);
+
+    if (s.copy == 0) {
+      sentAt[s.seq] = nowNs();
+      r.sent++;
+    }
+    if (dropped(rng)) continue;
+    sendto(tx, buf, sizeof(buf), 0, (sockaddr*)&addr, sizeof(addr));
+  }
+
+  senderDone = true;
+  rxThread.join();
+  r.duplicates = receiver.duplicates;
+
+  close(rx);
+  close(tx);
+  return r;
+}
+
+// ---------------------------
+// WEBSOCKET (TCP) PATH
+// ---------------------------
+static PathResult runWs(const Options& o) {
+  PathResult r;
+  r.name = "ws";
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  int one = 1;
+  setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in addr = loopback(o.port + 1);
+  if (bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 1) != 0) {
+    perror("tcp listen");
+    exit(1);
+  }
+
+  int client = socket(AF_INET, SOCK_STREAM, 0);
+  if (connect(client, (sockaddr*)&addr, sizeof(addr)) != 0) {
+    perror("tcp connect");
+    exit(1);
+  }
+  int server = accept(listener, nullptr, nullptr);
+  setsockopt(server, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+  setRecvTimeout(client, 50);
+
+  std::vector<std::atomic<int64_t>> sentAt(o.hits + 1);
+  std::atomic<bool> senderDone(false);
+
+  // Server -> client frames are unmasked: 0x81 0x03 'H' 'I' 'T'.
+  // TCP delivers in order, so the k-th complete frame is hit k.
+  std::thread rxThread([&] {
+    int64_t quietSince = 0;
+    uint8_t buf[4096];
+    size_t partial = 0;
+    while (r.delivered < o.hits) {
+      ssize_t n = recv(client, buf, sizeof(buf), 0);
+      int64_t t = nowNs();
+      if (n <= 0) {
+        if (!senderDone) continue;
+        if (!quietSince) quietSince = t;
+        if (t - quietSince > (int64_t)o.drainMs * 1000000) break;
+        continue;
+      }
+      quietSince = 0;
+
+      partial += (size_t)n;
+      while (partial >= 5 && r.delivered < o.hits) {
+        partial -= 5;
+        r.delivered++;
+        r.latencyUs.push_back((t - sentAt[r.delivered].load()) / 1000);
+      }
+    }
+  });
+
+  static const uint8_t frame[] = { 0x81, 0x03, 'H', 'I', 'T' };
+  int64_t t0 = nowNs() + 10000000;
+  for (int i = 1; i <= o.hits; i++) {
+    sleepUntilNs(t0 + (int64_t)(i - 1) * o.intervalUs * 1000);
+    sentAt[i] = nowNs();
+    send(server, frame, sizeof(frame), MSG_NOSIGNAL);
+    r.sent++;
+  }
+
+  senderDone = true;
+  rxThread.join();
+
+  close(client);
+  close(server);
+  close(listener);
+  return r;
+}
+
+// ---------------------------
+// REPORT
+// ---------------------------
+static int64_t percentile(const std::vector<int64_t>& sorted, double p) {
+  if (sorted.empty()) return -1;
+  size_t i = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+  return sorted[std::min(i, sorted.size() - 1)];
+}
+
+static void report(PathResult& r, const Options& o) {
+  std::sort(r.latencyUs.begin(), r.latencyUs.end());
+  const std::vector<int64_t>& l = r.latencyUs;
+  int lost = r.sent - r.delivered;
+  int64_t mx = l.empty() ? -1 : l.back();
+
+  if (o.json) {
+    printf("{\"path\":\"%s\",\"sent\":%d,\"delivered\":%d,\"lost\":%d,"
+           "\"duplicates\":%u,\"copies\":%d,\"drop\":%.4f,"
+           "\"p50_us\":%lld,\"p90_us\":%lld,\"p99_us\":%lld,"
+           "\"p999_us\":%lld,\"max_us\":%lld}\n",
+           r.name, r.sent, r.delivered, lost, r.duplicates,
+           strcmp(r.name, "udp") == 0 ? o.copies : 1, o.drop,
+           (long long)percentile(l, 0.50), (long long)percentile(l, 0.90),
+           (long long)percentile(l, 0.99), (long long)percentile(l, 0.999),
+           (long long)mx);
+    return;
+  }
+
+  printf("%-4s sent %5d  delivered %5d  lost %4d  dup %5u   "
+         "p50 %6lld  p90 %6lld  p99 %7lld  p99.9 %7lld  max %7lld us\n",
+         r.name, r.sent, r.delivered, lost, r.duplicates,
+         (long long)percentile(l, 0.50), (long long)percentile(l, 0.90),
+         (long long)percentile(l, 0.99), (long long)percentile(l, 0.999),
+         (long long)mx);
+}
+
+static void usage() {
+  fprintf(stderr,
+      "usage: udp_loopback_bench [--hits N] [--interval-us N] [--copies K]\n"
+      "                          [--spacing-us N] [--drop P] [--drain-ms N]\n"
+      "                          [--port N] [--json] [--only udp|ws]\n");
+  exit(2);
+}
+
+int main(int argc, char** argv) {
+  Options o;
+  std::string only;
+
+  for (int i = 1; i < argc; i++) {
+    std::string a = argv[i];
+    auto next = [&]() -> const char* {
+      if (i + 1 >= argc) usage();
+      return argv[++i];
+    };
+
+    if (a == "--hits") o.hits = atoi(next());
+    else if (a == "--interval-us") o.intervalUs = atoi(next());
+    else if (a == "--copies") o.copies = atoi(next());
+    else if (a == "--spacing-us") o.spacingUs = atoi(next());
+    else if (a == "--drop") o.drop = atof(next());
+    else if (a == "--drain-ms") o.drainMs = atoi(next());
+    else if (a == "--port") o.port = (uint16_t)atoi(next());
+    else if (a == "--only") only = next();
+    else if (a == "--json") o.json = true;
+    else usage();
+  }
+  if (o.hits < 1 || o.copies < 1 || o.copies > 255) usage();
+
+  if (only.empty() || only == "udp") {
+    PathResult udp = runUdp(o);
+    report(udp, o);
+  }
+  if (only.empty() || only == "ws") {
+    PathResult ws = runWs(o);
+    report(ws, o);
+  }
+  return 0;
+}